@@ -15,7 +15,10 @@
  */
 
 #include "graph/compute_graph.h"
+#include <atomic>
 #include <deque>
+#include <unordered_map>
+#include <unordered_set>
 #include "./format_refiner.h"
 #include "./ge_context.h"
 #include "debug/ge_attr_define.h"
@@ -54,6 +57,7 @@ bool IsUseBFS() {
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY ComputeGraph::ComputeGraph(const std::string &name)
     : name_(name), nodes_(), input_nodes_(), sub_graph_(), is_valid_flag_(false), need_iteration_(false) {
   attrs_.InitDefault();
+  attrs_ref_ = ComGraphMakeShared<char>(0);
 }
 
 ComputeGraph::~ComputeGraph() {}
@@ -62,13 +66,68 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY string ComputeGraph::GetName() co
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void ComputeGraph::SetName(const string &name) { name_ = name; }
 
+ComputeGraph::AllNodesIterator::AllNodesIterator(const ComputeGraph *root, const ComputeGraph *graph) : root_(root) {
+  if ((root != nullptr) && (graph != nullptr) && !graph->nodes_.empty()) {
+    frames_.push_back(Frame{graph, 0, 0});
+  }
+}
+
+ComputeGraph::AllNodesIterator &ComputeGraph::AllNodesIterator::operator++() {
+  while (!frames_.empty()) {
+    auto &frame = frames_.back();
+    // 1. enter the next non-empty subgraph of the current node
+    const auto *subgraph_names = GetSubgraphNames(frame.graph->nodes_[frame.node_index].get());
+    while ((subgraph_names != nullptr) && (frame.subgraph_index < subgraph_names->size())) {
+      const auto &name = (*subgraph_names)[frame.subgraph_index++];
+      auto iter = root_->names_to_subgraph_.find(name);
+      if ((iter != root_->names_to_subgraph_.end()) && (iter->second != nullptr) && !iter->second->nodes_.empty()) {
+        frames_.push_back(Frame{iter->second.get(), 0, 0});
+        return *this;
+      }
+    }
+    // 2. move to the next node of the current graph
+    if (++frame.node_index < frame.graph->nodes_.size()) {
+      frame.subgraph_index = 0;
+      return *this;
+    }
+    // 3. back to the node owning the current graph, to visit its remaining subgraphs
+    frames_.pop_back();
+  }
+  return *this;
+}
+
+const std::vector<std::string> *ComputeGraph::GetSubgraphNames(const Node *node) {
+  if ((node == nullptr) || (node->op_ == nullptr)) {
+    return nullptr;
+  }
+  return &node->op_->GetSubgraphInstanceNames();
+}
+
+GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY ComputeGraph::AllNodesRange ComputeGraph::AllNodes() const {
+  std::shared_ptr<ConstComputeGraph> root = shared_from_this();
+  for (auto parent = parent_graph_.lock(); parent != nullptr; parent = parent->parent_graph_.lock()) {
+    root = parent;
+  }
+  return AllNodesRange(shared_from_this(), root);
+}
+
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY size_t ComputeGraph::GetAllNodesSize() const {
-  return GetAllNodes().size();
+  auto all_nodes = AllNodes();
+  size_t size = 0;
+  for (auto iter = all_nodes.begin(); iter != all_nodes.end(); ++iter) {
+    ++size;
+  }
+  return size;
 }
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY ComputeGraph::Vistor<NodePtr> ComputeGraph::GetAllNodes() const {
-  std::vector<std::shared_ptr<ComputeGraph>> subgraphs;
-  return AllGraphNodes(subgraphs);
+  auto all_nodes = AllNodes();
+  std::vector<NodePtr> nodes;
+  nodes.reserve(nodes_.size());
+  for (const auto &node : all_nodes) {
+    nodes.emplace_back(node);
+  }
+  return Vistor<NodePtr>(shared_from_this(), nodes);
 }
 
 ComputeGraph::Vistor<NodePtr> ComputeGraph::AllGraphNodes(std::vector<std::shared_ptr<ComputeGraph>> &subgraphs) const {
@@ -153,7 +212,7 @@ NodePtr ComputeGraph::FindFirstNodeMatchType(const std::string &name) const {
     if (node == nullptr) {
       continue;
     }
-    if (node->GetType() == name) {
+    if (node->GetTypeRef() == name) {
       return node;
     }
   }
@@ -270,7 +329,7 @@ NodePtr ComputeGraph::AddNodeFront(NodePtr node) {
   }
   node->SetHostNode(is_valid_flag_);
   node->GetOpDesc()->SetId(nodes_.size());
-  if (nodes_.size() > 0 && nodes_[0]->GetType() == DATA) {
+  if (nodes_.size() > 0 && nodes_[0]->GetTypeRef() == DATA) {
     (void)nodes_.insert(nodes_.begin() + 1, node);
   } else {
     (void)nodes_.insert(nodes_.begin(), node);
@@ -379,7 +438,8 @@ graphStatus ComputeGraph::RemoveConstInput(const NodePtr &node) {
     if (out_anchor == nullptr || out_anchor->GetOwnerNode() == nullptr) {
       continue;
     }
-    if (out_anchor->GetOwnerNode()->GetType() == CONSTANT || out_anchor->GetOwnerNode()->GetType() == CONSTANTOP) {
+    if (out_anchor->GetOwnerNode()->GetTypeRef() == CONSTANT ||
+        out_anchor->GetOwnerNode()->GetTypeRef() == CONSTANTOP) {
       GE_CHK_BOOL_RET_STATUS(GraphUtils::RemoveEdge(out_anchor, in_anchor) == GRAPH_SUCCESS, GRAPH_FAILED,
                              "Remove edge from const op failed.");
       if (out_anchor->GetOwnerNode()->GetOutNodes().size() == 0) {
@@ -414,6 +474,9 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus ComputeGraph::RemoveN
     return GRAPH_FAILED;
   }
 
+  RemoveMarkedNode(need_infer_nodes_, need_infer_node_set_, node);
+  RemoveMarkedNode(need_verify_nodes_, need_verify_node_set_, node);
+
   auto iter = find(nodes_.begin(), nodes_.end(), node);
   if (iter != nodes_.end()) {
     (void)nodes_.erase(iter);
@@ -594,7 +657,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void ComputeGraph::SetParentNode(
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus
 ComputeGraph::UpdateInputMapping(const std::map<uint32_t, uint32_t> &input_mapping) {
   for (auto &input : nodes_) {
-    if (input->GetType() == DATA) {
+    if (input->GetTypeRef() == DATA) {
       uint32_t cur_index = 0;
       if (!ge::AttrUtils::GetInt(input->GetOpDesc(), ATTR_NAME_PARENT_NODE_INDEX, cur_index)) {
         continue;
@@ -663,7 +726,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus ComputeGraph::InsertE
       continue;
     }
     GE_IF_BOOL_EXEC(node == nullptr, GELOGE(GRAPH_FAILED, "The node should not be null."); return GRAPH_FAILED);
-    if (node->GetOpDesc()->GetType() == RECV) {
+    if (node->GetOpDesc()->GetTypeRef() == RECV) {
       auto iter = find(node_vec.begin(), node_vec.end(), node);
       if (iter == node_vec.end()) {
         GELOGW("no node found.");
@@ -674,7 +737,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus ComputeGraph::InsertE
       auto dst_iter = find(node_vec.begin(), node_vec.end(), node->GetOutControlNodes().at(0));
       (void)node_vec.insert(dst_iter, node);
     }
-    if (node->GetOpDesc()->GetType() == SEND) {
+    if (node->GetOpDesc()->GetTypeRef() == SEND) {
       auto iter = find(node_vec.begin(), node_vec.end(), node);
       if (iter == node_vec.end()) {
         GELOGW("no node found.");
@@ -909,8 +972,8 @@ graphStatus ComputeGraph::SortNodes(std::vector<NodePtr> &stack, std::map<NodePt
     GE_IF_BOOL_EXEC(node->GetOpDesc() == nullptr, continue);
     map_in_edge_num[node] = static_cast<uint32_t>(GetInEdgeSize(node));
     if (map_in_edge_num[node] == 0) {
-      if ((node->GetOpDesc()->GetType() != DATA) && (node->GetOpDesc()->GetType() != AIPPDATA) &&
-          (node->GetOpDesc()->GetType() != INPUT_TYPE) && (node->GetOpDesc()->GetType() != ANN_DATA)) {
+      if ((node->GetOpDesc()->GetTypeRef() != DATA) && (node->GetOpDesc()->GetTypeRef() != AIPPDATA) &&
+          (node->GetOpDesc()->GetTypeRef() != INPUT_TYPE) && (node->GetOpDesc()->GetTypeRef() != ANN_DATA)) {
         // At present, can only judge the isolated point without input and output.
         // It is impossible to judge the situation with multiple output nodes.
         if (verify_isolated && GetOutEdgeSize(node) == 0) {
@@ -964,7 +1027,7 @@ size_t ComputeGraph::GetInEdgeSize(const NodePtr &node) {
         GELOGW("out node is nullptr");
         continue;
       }
-      if ((out_node->GetType() == NEXTITERATION) || (out_node->GetType() == REFNEXTITERATION)) {
+      if ((out_node->GetTypeRef() == NEXTITERATION) || (out_node->GetTypeRef() == REFNEXTITERATION)) {
         GE_IF_BOOL_EXEC(in_edge_size == 0, GELOGE(GRAPH_FAILED, "If [in_edge_size = 0], the result will be reversed");
                         return in_edge_size);
         in_edge_size -= 1;
@@ -984,7 +1047,7 @@ size_t ComputeGraph::GetOutEdgeSize(const NodePtr &node) {
   }
 
   // Break flow control data loop.
-  if ((node->GetType() != NEXTITERATION) && (node->GetType() != REFNEXTITERATION)) {
+  if ((node->GetTypeRef() != NEXTITERATION) && (node->GetTypeRef() != REFNEXTITERATION)) {
     for (const auto &anchor : node->GetAllOutDataAnchors()) {
       if (anchor != nullptr) {
         out_edge_size = out_edge_size + anchor->GetPeerAnchors().size();
@@ -1004,7 +1067,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool ComputeGraph::IsValid() cons
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void ComputeGraph::Dump() const {
   GELOGI("graph name = %s.", GetName().c_str());
-  for (const auto &node : GetAllNodes()) {
+  for (const auto &node : AllNodes()) {
     GELOGD("node name = %s.", node->GetName().c_str());
     for (const auto &anchor : node->GetAllOutDataAnchors()) {
       for (const auto &peer_in_anchor : anchor->GetPeerInDataAnchors()) {
@@ -1042,9 +1105,14 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void ComputeGraph::Swap(ComputeGr
   name_.swap(graph.name_);
   std::swap(graph_id_, graph.graph_id_);
   attrs_.Swap(graph.attrs_);
+  attrs_ref_.swap(graph.attrs_ref_);
   nodes_.swap(graph.nodes_);
   all_nodes_infos_.swap(graph.all_nodes_infos_);
   target_nodes_info_.swap(graph.target_nodes_info_);
+  need_infer_nodes_.swap(graph.need_infer_nodes_);
+  need_infer_node_set_.swap(graph.need_infer_node_set_);
+  need_verify_nodes_.swap(graph.need_verify_nodes_);
+  need_verify_node_set_.swap(graph.need_verify_node_set_);
 
   input_nodes_.swap(graph.input_nodes_);
   inputs_order_.swap(graph.inputs_order_);
@@ -1092,8 +1160,8 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus ComputeGraph::Isolate
     if (pre_out_data_anchor != nullptr) {
       GE_CHK_BOOL_EXEC(GraphUtils::RemoveEdge(pre_out_data_anchor, in_data_anchor) == GRAPH_SUCCESS,
                        return GRAPH_FAILED, "remove edge failed");
-      GE_IF_BOOL_EXEC(pre_out_data_anchor->GetOwnerNode()->GetType() == CONSTANT ||
-                          pre_out_data_anchor->GetOwnerNode()->GetType() == CONSTANTOP,
+      GE_IF_BOOL_EXEC(pre_out_data_anchor->GetOwnerNode()->GetTypeRef() == CONSTANT ||
+                          pre_out_data_anchor->GetOwnerNode()->GetTypeRef() == CONSTANTOP,
                       continue);
       for (const auto &out_data_anchor : node->GetAllOutDataAnchors()) {
         for (const auto &next_in_data_anchor : out_data_anchor->GetPeerInDataAnchors()) {
@@ -1186,7 +1254,7 @@ graphStatus ComputeGraph::RemoveExtraOutEdge(const NodePtr &node) {
 
 graphStatus ComputeGraph::Verify() {
   bool is_unknown_graph = GetGraphUnknownFlag();
-  for (const auto &node_ptr : GetAllNodes()) {
+  for (const auto &node_ptr : AllNodes()) {
     GE_CHECK_NOTNULL(node_ptr);
     GE_CHECK_NOTNULL(node_ptr->GetOpDesc());
     GE_IF_BOOL_EXEC(is_unknown_graph, continue);
@@ -1202,7 +1270,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus ComputeGraph::InferOr
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus ComputeGraph::InferShapeInNeed() {
   GE_CHK_BOOL_ONLY_LOG(TopologicalSorting() == GRAPH_SUCCESS, "Verifying failed.");
-  for (const auto &node_ptr : GetAllNodes()) {
+  for (const auto &node_ptr : AllNodes()) {
     GE_CHECK_NOTNULL(node_ptr);
     auto op_desc = node_ptr->GetOpDesc();
     bool is_need_infer = false;
@@ -1212,28 +1280,238 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus ComputeGraph::InferSh
                        node_ptr->GetName().c_str());
 
       graphStatus status = node_ptr->InferShapeAndType();
-      GE_CHK_BOOL_EXEC_INFO(node_ptr->GetType() == DATA || GRAPH_PARAM_INVALID != status, break,
+      GE_CHK_BOOL_EXEC_INFO(node_ptr->GetTypeRef() == DATA || GRAPH_PARAM_INVALID != status, break,
                             "Op %s does not have the IMPLEMT_INFERFUNC definition,"
                             " and subsequent operators no longer perform shape inference.",
                             node_ptr->GetName().c_str());
       GE_CHK_BOOL_EXEC(status == GRAPH_SUCCESS, return GRAPH_FAILED, "Inferring %s failed.",
                        node_ptr->GetName().c_str());
 
-      for (const auto &out_anchor : node_ptr->GetAllOutDataAnchors()) {
-        GE_CHECK_NOTNULL(out_anchor->GetOwnerNode()->GetOpDesc());
-        auto output_tensor = out_anchor->GetOwnerNode()->GetOpDesc()->GetOutputDesc(out_anchor->GetIdx());
-        ge::TensorUtils::SetRealDimCnt(output_tensor, output_tensor.GetShape().GetDims().size());
-        (void)out_anchor->GetOwnerNode()->GetOpDesc()->UpdateOutputDesc(out_anchor->GetIdx(), output_tensor);
-        for (const auto &peer_anchor : out_anchor->GetPeerInDataAnchors()) {
-          (void)peer_anchor->GetOwnerNode()->GetOpDesc()->UpdateInputDesc(peer_anchor->GetIdx(), output_tensor);
+      GE_CHK_STATUS_RET_NOLOG(UpdatePeerInputDescs(node_ptr, nullptr));
+    }
+  }
+  return GRAPH_SUCCESS;
+}
+
+graphStatus ComputeGraph::UpdatePeerInputDescs(const NodePtr &node, std::vector<NodePtr> *consumers) {
+  auto op_desc = node->GetOpDesc();
+  GE_CHECK_NOTNULL(op_desc);
+  for (const auto &out_anchor : node->GetAllOutDataAnchors()) {
+    auto output_tensor = op_desc->MutableOutputDesc(static_cast<uint32_t>(out_anchor->GetIdx()));
+    if (output_tensor == nullptr) {
+      continue;
+    }
+    ge::TensorUtils::SetRealDimCnt(*output_tensor, output_tensor->GetShape().GetDims().size());
+    for (const auto &peer_anchor : out_anchor->GetPeerInDataAnchors()) {
+      auto peer_node = peer_anchor->GetOwnerNode();
+      GE_CHECK_NOTNULL(peer_node);
+      GE_CHECK_NOTNULL(peer_node->GetOpDesc());
+      auto peer_op_desc = peer_node->GetOpDesc();
+      const auto peer_index = static_cast<uint32_t>(peer_anchor->GetIdx());
+      auto input_tensor = peer_op_desc->MutableInputDesc(peer_index);
+      if (input_tensor != nullptr) {
+        *input_tensor = *output_tensor;
+      } else {
+        // input descs not valid yet are not returned by MutableInputDesc, they are replaced instead
+        (void)peer_op_desc->UpdateInputDesc(peer_index, *output_tensor);
+      }
+      if (consumers != nullptr) {
+        consumers->push_back(peer_node);
+      }
+    }
+  }
+  return GRAPH_SUCCESS;
+}
+
+std::vector<ComputeGraph *> ComputeGraph::GetGraphsWithSubgraphs() {
+  std::vector<ComputeGraph *> graphs{this};
+  for (const auto &subgraph : sub_graph_) {
+    if (subgraph != nullptr) {
+      graphs.push_back(subgraph.get());
+    }
+  }
+  return graphs;
+}
+
+void ComputeGraph::AddMarkedNode(std::vector<NodePtr> &marked_nodes, std::unordered_set<NodePtr> &marked_node_set,
+                                 const NodePtr &node) {
+  if (marked_node_set.insert(node).second) {
+    marked_nodes.push_back(node);
+  }
+}
+
+void ComputeGraph::RemoveMarkedNode(std::vector<NodePtr> &marked_nodes, std::unordered_set<NodePtr> &marked_node_set,
+                                    const NodePtr &node) {
+  if (marked_node_set.erase(node) == 0) {
+    return;
+  }
+  auto iter = find(marked_nodes.begin(), marked_nodes.end(), node);
+  if (iter != marked_nodes.end()) {
+    (void)marked_nodes.erase(iter);
+  }
+}
+
+bool ComputeGraph::IsMarkedNodeOwned(const NodePtr &node) const {
+  // a node moved to another graph without RemoveNode keeps its mark here, it is not handled by this graph
+  auto owner_graph = node->GetOwnerComputeGraph();
+  if ((owner_graph != nullptr) && (owner_graph.get() != this)) {
+    GELOGD("Skip marked node %s, it is owned by graph %s now.", node->GetName().c_str(),
+           owner_graph->GetName().c_str());
+    return false;
+  }
+  return true;
+}
+
+void ComputeGraph::MarkNodeNeedInfer(const NodePtr &node) {
+  if ((node == nullptr) || (node->GetOpDesc() == nullptr)) {
+    GELOGW("Mark need infer failed, node or op desc is null.");
+    return;
+  }
+  // keep the attr for callers still using InferShapeInNeed
+  (void)AttrUtils::SetBool(node->GetOpDesc(), NEED_INFER, true);
+  auto owner_graph = node->GetOwnerComputeGraph();
+  ComputeGraph *graph = (owner_graph == nullptr) ? this : owner_graph.get();
+  AddMarkedNode(graph->need_infer_nodes_, graph->need_infer_node_set_, node);
+}
+
+void ComputeGraph::MarkNodeNeedVerify(const NodePtr &node) {
+  if (node == nullptr) {
+    GELOGW("Mark need verify failed, node is null.");
+    return;
+  }
+  auto owner_graph = node->GetOwnerComputeGraph();
+  ComputeGraph *graph = (owner_graph == nullptr) ? this : owner_graph.get();
+  AddMarkedNode(graph->need_verify_nodes_, graph->need_verify_node_set_, node);
+}
+
+graphStatus ComputeGraph::InferShapeOfMarkedNodes() {
+  auto graphs = GetGraphsWithSubgraphs();
+  std::vector<NodePtr> marked_nodes;
+  for (const auto graph : graphs) {
+    for (const auto &node : graph->need_infer_nodes_) {
+      if (graph->IsMarkedNodeOwned(node)) {
+        marked_nodes.push_back(node);
+      }
+    }
+  }
+
+  // unmarked nodes are not inferred again, so only direct edges between marked nodes decide the order
+  std::unordered_map<const Node *, uint32_t> in_edge_num;
+  for (const auto &node : marked_nodes) {
+    in_edge_num[node.get()] = 0;
+  }
+  for (const auto &node : marked_nodes) {
+    for (const auto &out_node : node->GetOutDataNodes()) {
+      auto iter = in_edge_num.find(out_node.get());
+      if (iter != in_edge_num.end()) {
+        ++iter->second;
+      }
+    }
+  }
+  std::deque<NodePtr> ready_nodes;
+  for (const auto &node : marked_nodes) {
+    if (in_edge_num[node.get()] == 0) {
+      ready_nodes.push_back(node);
+    }
+  }
+
+  size_t inferred_num = 0;
+  bool infer_stopped = false;
+  std::unordered_set<const Node *> inferred_nodes;
+  std::vector<NodePtr> consumers;
+  while (!ready_nodes.empty()) {
+    NodePtr node = ready_nodes.front();
+    ready_nodes.pop_front();
+    ++inferred_num;
+    GE_CHK_BOOL_EXEC(node->Verify() == GRAPH_SUCCESS, return GRAPH_FAILED, "Verifying %s failed.",
+                     node->GetName().c_str());
+
+    graphStatus status = node->InferShapeAndType();
+    GE_CHK_BOOL_EXEC_INFO(node->GetTypeRef() == DATA || GRAPH_PARAM_INVALID != status, infer_stopped = true; break,
+                          "Op %s does not have the IMPLEMT_INFERFUNC definition,"
+                          " and subsequent operators no longer perform shape inference.",
+                          node->GetName().c_str());
+    GE_CHK_BOOL_EXEC(status == GRAPH_SUCCESS, return GRAPH_FAILED, "Inferring %s failed.", node->GetName().c_str());
+    GE_CHK_STATUS_RET_NOLOG(UpdatePeerInputDescs(node, &consumers));
+    (void)inferred_nodes.insert(node.get());
+
+    for (const auto &out_node : node->GetOutDataNodes()) {
+      auto iter = in_edge_num.find(out_node.get());
+      if ((iter != in_edge_num.end()) && (--iter->second == 0)) {
+        ready_nodes.push_back(out_node);
+      }
+    }
+  }
+  if (!infer_stopped && (inferred_num < marked_nodes.size())) {
+    GELOGE(GRAPH_FAILED, "Marked nodes of graph %s have a cycle, inferred %zu of %zu.", name_.c_str(), inferred_num,
+           marked_nodes.size());
+    return GRAPH_FAILED;
+  }
+
+  // nodes not reached because inference stopped keep their marks, marks of nodes moved to other graphs are dropped
+  for (const auto graph : graphs) {
+    std::vector<NodePtr> remaining_nodes;
+    if (infer_stopped) {
+      for (const auto &node : graph->need_infer_nodes_) {
+        if ((inferred_nodes.count(node.get()) == 0) && graph->IsMarkedNodeOwned(node)) {
+          remaining_nodes.push_back(node);
         }
       }
     }
+    graph->need_infer_nodes_.swap(remaining_nodes);
+    graph->need_infer_node_set_ =
+        std::unordered_set<NodePtr>(graph->need_infer_nodes_.begin(), graph->need_infer_nodes_.end());
+  }
+  for (const auto &consumer : consumers) {
+    MarkNodeNeedVerify(consumer);
   }
   return GRAPH_SUCCESS;
 }
 
-ProtoAttrMapHelper ComputeGraph::MutableAttrMap() { return attrs_; }
+graphStatus ComputeGraph::VerifyMarkedNodes() {
+  bool is_unknown_graph = GetGraphUnknownFlag();
+  auto graphs = GetGraphsWithSubgraphs();
+  for (const auto graph : graphs) {
+    for (const auto &node_ptr : graph->need_verify_nodes_) {
+      GE_CHECK_NOTNULL(node_ptr);
+      GE_CHECK_NOTNULL(node_ptr->GetOpDesc());
+      GE_IF_BOOL_EXEC(is_unknown_graph || !graph->IsMarkedNodeOwned(node_ptr), continue);
+      GE_CHK_BOOL_EXEC(node_ptr->GetOpDesc()->CommonVerify() == GRAPH_SUCCESS, return GRAPH_FAILED,
+                       "Verifying %s failed.", node_ptr->GetName().c_str());
+    }
+  }
+  for (const auto graph : graphs) {
+    graph->need_verify_nodes_.clear();
+    graph->need_verify_node_set_.clear();
+  }
+  return GRAPH_SUCCESS;
+}
+
+void ComputeGraph::ShareAttrsFrom(const ComputeGraph &graph) {
+  if (&graph == this) {
+    return;
+  }
+  if (graph.attrs_ref_ == nullptr) {
+    CopyAttrsFrom(graph);
+    return;
+  }
+  attrs_ = graph.attrs_;
+  attrs_ref_ = graph.attrs_ref_;
+}
+
+ProtoAttrMapHelper ComputeGraph::MutableAttrMap() {
+  if ((attrs_ref_ == nullptr) || (attrs_ref_.use_count() == 1)) {
+    // the last graph holding the attrs changes them in place, ordered after the release of the other graphs
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return attrs_;
+  }
+  ProtoAttrMapHelper attrs;
+  attrs.InitDefault();
+  attrs.CopyValueFrom(GetAttrMap());
+  attrs_ = attrs;
+  attrs_ref_ = ComGraphMakeShared<char>(0);
+  return attrs_;
+}
 
 ConstProtoAttrMapHelper ComputeGraph::GetAttrMap() const {
   return ConstProtoAttrMapHelper(attrs_.GetProtoOwner(), attrs_.GetProtoMsg());
@@ -74,7 +74,7 @@ graphStatus ReflectionProcess(const std::unordered_set<RefCell, RefCellHash> &re
 
 graphStatus BiasAddFormatFixProcess(ge::NodePtr &node_ptr) {
   // 5 meas dim num
-  if (node_ptr->GetType() != "BiasAdd") {
+  if (node_ptr->GetTypeRef() != "BiasAdd") {
     return GRAPH_SUCCESS;
   }
   std::unordered_map<string, Format> kTfFormatFix = {
@@ -117,7 +117,7 @@ graphStatus BiasAddFormatFixProcess(ge::NodePtr &node_ptr) {
 graphStatus FormatRefiner::RefreshConstantOutProcess(const ComputeGraphPtr &graph, const OpDescPtr &op_desc) {
   GE_CHECK_NOTNULL(graph);
   GE_CHECK_NOTNULL(op_desc);
-  if (op_desc->GetType() == CONSTANTOP && !IsGraphInferred(graph)) {
+  if (op_desc->GetTypeRef() == CONSTANTOP && !IsGraphInferred(graph)) {
     ConstGeTensorPtr tensor_value;
     if (!AttrUtils::GetTensor(op_desc, "value", tensor_value)) {
       GELOGE(GRAPH_FAILED, "Get value failed, node name:%s.", op_desc->GetName().c_str());
@@ -160,7 +160,7 @@ graphStatus FormatRefiner::GetAnchorPoints(const ge::ComputeGraphPtr &graph, std
       GE_IF_BOOL_EXEC(op_desc->MutableInputDesc(i) == nullptr, continue);
       auto input_format = op_desc->MutableInputDesc(i)->GetFormat();
       // Pre-save data node (only main graph data) and default infer fail
-      if (node_ptr->GetType() == DATA) {
+      if (node_ptr->GetTypeRef() == DATA) {
         data_nodes.push_back(node_ptr);
       }
       if (input_format != FORMAT_ND && input_format != FORMAT_RESERVED) {
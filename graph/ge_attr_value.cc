@@ -340,6 +340,25 @@ class AttrUtilsHelper {
     return true;
   }
 
+  // Find only, unlike MutableAttrMapItem the item is not added if missing
+  static bool FindMutableAttrMapItem(AttrHolder *obj, const string &name, proto::AttrDef *&attr_def) {
+    if (obj == nullptr) {
+      GELOGE(FAILED, "%s obj is nullptr", name.c_str());
+      return false;
+    }
+    auto attr_map = obj->MutableAttrMap().GetProtoMsg();
+    if (attr_map == nullptr) {
+      GELOGE(FAILED, "%s attr map is nullptr", name.c_str());
+      return false;
+    }
+    auto it = attr_map->find(name);
+    if (it == attr_map->end()) {
+      return false;
+    }
+    attr_def = &it->second;
+    return true;
+  }
+
   inline static bool MutableAttrMapItem(AttrHolder *obj, const string &name, proto::AttrDef *&attr_def) {
     if (obj == nullptr) {
       GELOGE(FAILED, " %s obj is nullptr", name.c_str());
@@ -1026,8 +1045,8 @@ bool AttrUtils::GetListTensor(ConstAttrHolderAdapter &&obj, const string &name,
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool AttrUtils::MutableTensor(AttrHolderAdapter &&obj,
                                                                              const string &name, GeTensorPtr &value) {
-  const proto::AttrDef *proto_attr_val = nullptr;
-  if (!AttrUtilsHelper::GetAttrMapItem(obj.get(), name, proto_attr_val) || proto_attr_val == nullptr) {
+  proto::AttrDef *proto_attr_val = nullptr;
+  if (!AttrUtilsHelper::FindMutableAttrMapItem(obj.get(), name, proto_attr_val) || proto_attr_val == nullptr) {
     return false;
   }
   return GeAttrValueImp::GetValue(*proto_attr_val, obj->GetAttrMap().GetProtoOwner(), value);
@@ -1035,8 +1054,8 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool AttrUtils::MutableTensor(Att
 
 bool AttrUtils::MutableListTensor(AttrHolderAdapter &&obj, const string &name, vector<GeTensorPtr> &value) {
   value.clear();
-  const proto::AttrDef *proto_attr_val = nullptr;
-  if (!AttrUtilsHelper::GetAttrMapItem(obj.get(), name, proto_attr_val) || proto_attr_val == nullptr) {
+  proto::AttrDef *proto_attr_val = nullptr;
+  if (!AttrUtilsHelper::FindMutableAttrMapItem(obj.get(), name, proto_attr_val) || proto_attr_val == nullptr) {
     return false;
   }
   return GeAttrValueImp::GetValue(*proto_attr_val, obj->GetAttrMap().GetProtoOwner(), value);
@@ -1231,6 +1250,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY OpDescPtr AttrUtils::CloneOpDesc(
   if (!op_desc->optional_input_names_.empty()) {
     op_desc->optional_input_names_.clear();
   }
+  op_desc->ClearIdxNameCache();
 
   return op_desc;
 }
@@ -1258,6 +1278,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY OpDescPtr AttrUtils::CopyOpDesc(c
   op_desc->optional_input_names_.insert(org_op_desc->optional_input_names_.begin(),
                                         org_op_desc->optional_input_names_.end());
   op_desc->output_name_idx_.insert(org_op_desc->output_name_idx_.begin(), org_op_desc->output_name_idx_.end());
+  op_desc->ClearIdxNameCache();
 
   op_desc->infer_func_ = org_op_desc->infer_func_;
   op_desc->infer_format_func_ = org_op_desc->infer_format_func_;
@@ -608,6 +608,7 @@ GeTensorDesc &GeTensorDesc::operator=(GeTensorDesc &&desc) {
 
 GeTensor::GeTensor::GeTensor() {
   tensor_def_.InitDefault();
+  copy_on_write_ = ComGraphMakeShared<std::atomic<bool>>(false);
   // Default init desc
   DescReference() = GeTensorDesc();
 }
@@ -657,7 +658,12 @@ GeTensor::GeTensor(const ProtoMsgOwner &proto_owner, proto::TensorDef *proto_msg
 
 GeTensorDesc GeTensor::GetTensorDesc() const { return DescReference(); }
 
-GeTensorDesc &GeTensor::MutableTensorDesc() { return DescReference(); }
+const GeTensorDesc &GeTensor::GetTensorDescRef() const { return DescReference(); }
+
+GeTensorDesc &GeTensor::MutableTensorDesc() {
+  CopyBeforeWrite(true);
+  return DescReference();
+}
 
 GeTensorDesc &GeTensor::DescReference() const {
   if (tensor_def_.GetProtoMsg() != nullptr) {
@@ -670,7 +676,10 @@ GeTensorDesc &GeTensor::DescReference() const {
   return __desc_;
 }
 
-void GeTensor::SetTensorDesc(const GeTensorDesc &tensor_desc) { DescReference() = tensor_desc; }
+void GeTensor::SetTensorDesc(const GeTensorDesc &tensor_desc) {
+  CopyBeforeWrite(true);
+  DescReference() = tensor_desc;
+}
 
 const Buffer GeTensor::GetData() const {
   auto proto_msg = tensor_def_.GetProtoMsg();
@@ -681,6 +690,7 @@ const Buffer GeTensor::GetData() const {
 }
 
 Buffer GeTensor::MutableData() {
+  CopyBeforeWrite(true);
   auto proto_msg = tensor_def_.GetProtoMsg();
   if (proto_msg != nullptr) {
     return Buffer(tensor_def_.GetProtoOwner(), proto_msg->mutable_data());
@@ -689,6 +699,7 @@ Buffer GeTensor::MutableData() {
 }
 
 graphStatus GeTensor::SetData(vector<uint8_t> &&data) {
+  CopyBeforeWrite(false);
   auto proto_msg = tensor_def_.GetProtoMsg();
   GE_CHECK_NOTNULL(proto_msg);
   proto_msg->set_data(data.data(), data.size());
@@ -696,6 +707,7 @@ graphStatus GeTensor::SetData(vector<uint8_t> &&data) {
 }
 
 graphStatus GeTensor::SetData(const vector<uint8_t> &data) {
+  CopyBeforeWrite(false);
   auto proto_msg = tensor_def_.GetProtoMsg();
   GE_CHECK_NOTNULL(proto_msg);
   proto_msg->set_data(data.data(), data.size());
@@ -706,6 +718,7 @@ graphStatus GeTensor::SetData(const uint8_t *data, size_t size) {
   if (size > 0) {
     GE_CHECK_NOTNULL(data);
   }
+  CopyBeforeWrite(false);
   auto proto_msg = tensor_def_.GetProtoMsg();
   GE_CHECK_NOTNULL(proto_msg);
   proto_msg->set_data(data, size);
@@ -713,6 +726,7 @@ graphStatus GeTensor::SetData(const uint8_t *data, size_t size) {
 }
 
 graphStatus GeTensor::SetData(const Buffer &data) {
+  CopyBeforeWrite(false);
   auto proto_msg = tensor_def_.GetProtoMsg();
   GE_CHECK_NOTNULL(proto_msg);
   if (data.size() == 0) {
@@ -731,11 +745,42 @@ GeTensor GeTensor::Clone() const {
   return tensor;
 }
 
-GeTensor::GeTensor(const GeTensor &other) { tensor_def_ = other.tensor_def_; }
+GeTensor GeTensor::ShareCopyOnWrite() const {
+  auto proto_msg = tensor_def_.GetProtoMsg();
+  // value owned by others, e.g. an attr map, may be changed or released behind us
+  if ((proto_msg == nullptr) || (copy_on_write_ == nullptr) || (tensor_def_.GetProtoOwner().get() != proto_msg)) {
+    return Clone();
+  }
+  copy_on_write_->store(true);
+  return *this;
+}
+
+void GeTensor::CopyBeforeWrite(bool keep_data) {
+  if ((copy_on_write_ == nullptr) || !copy_on_write_->load()) {
+    return;
+  }
+  // the last handle of the value writes in place, the fence orders the write after the other handles' release
+  if (copy_on_write_.use_count() == 1) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return;
+  }
+  GeTensor tensor;
+  if (keep_data) {
+    tensor.tensor_def_.CopyValueFrom(tensor_def_);
+  } else {
+    // data is about to be replaced, only the desc is copied
+    tensor.DescReference() = DescReference();
+  }
+  tensor_def_ = tensor.tensor_def_;
+  copy_on_write_ = tensor.copy_on_write_;
+}
+
+GeTensor::GeTensor(const GeTensor &other) : tensor_def_(other.tensor_def_), copy_on_write_(other.copy_on_write_) {}
 
 GeTensor &GeTensor::operator=(const GeTensor &other) {
   if (&other != this) {
     tensor_def_ = other.tensor_def_;
+    copy_on_write_ = other.copy_on_write_;
   }
   return *this;
 }
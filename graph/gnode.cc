@@ -278,11 +278,11 @@ graphStatus GNode::GetInputConstData(const int32_t index, Tensor &data) const {
     return SUCCESS;
   } else if (op_type == DATA) {
     auto parent_node = NodeUtils::GetParentInput(input_data_node);
-    while ((parent_node != nullptr) && (parent_node->GetType() == DATA)) {
+    while ((parent_node != nullptr) && (parent_node->GetTypeRef() == DATA)) {
       parent_node = NodeUtils::GetParentInput(parent_node);
     }
     if ((parent_node != nullptr) &&
-        ((parent_node->GetType() == CONSTANT) || (parent_node->GetType() == CONSTANTOP))) {
+        ((parent_node->GetTypeRef() == CONSTANT) || (parent_node->GetTypeRef() == CONSTANTOP))) {
       Operator const_op =  OpDescUtils::CreateOperatorFromNode(parent_node);
       if (const_op.GetAttr(ATTR_NAME_WEIGHTS, data) != GRAPH_SUCCESS) {
         GELOGE(GRAPH_FAILED, "Input data node[%s] of node[%s] get data failed.",
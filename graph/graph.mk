@@ -37,6 +37,7 @@ COMMON_LOCAL_SRC_FILES := \
     ./utils/ge_ir_utils.cc \
     ./utils/op_desc_utils.cc \
     ./utils/type_utils.cc \
+    ./utils/op_type_utils.cc \
     ./utils/tensor_utils.cc \
     ./tensor.cc \
     ./debug/graph_debug.cc \
@@ -284,6 +284,7 @@ void ModelSerializeImp::AttrDefToOpDesc(OpDescPtr &op_desc,
       }
     }
   }
+  op_desc->ClearIdxNameCache();
   if (!opt_input.empty()) {
     for (const auto &i : opt_input) {
       op_desc->optional_input_names_.insert(i);
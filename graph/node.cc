@@ -106,6 +106,23 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY std::string Node::GetType() const
   return op_->GetType();
 }
 
+GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY const std::string &Node::GetNameRef() const {
+  static const std::string empty_name;
+  GE_CHK_BOOL_EXEC(op_ != nullptr, return empty_name, "original OpDesc is nullptr");
+  return op_->GetNameRef();
+}
+
+GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY const std::string &Node::GetTypeRef() const {
+  static const std::string empty_type;
+  GE_CHK_BOOL_EXEC(op_ != nullptr, return empty_type, "original OpDesc is nullptr");
+  return op_->GetTypeRef();
+}
+
+GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY OpTypeId Node::GetTypeId() const {
+  GE_CHK_BOOL_EXEC(op_ != nullptr, return OpTypeUtils::kEmptyOpTypeId, "original OpDesc is nullptr");
+  return op_->GetTypeId();
+}
+
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool Node::NodeAttrsAreEqual(const Node &r_node) const {
   const auto &attr_map = this->attrs_;
   const auto &r_attr_map = r_node.attrs_;
@@ -573,7 +590,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool Node::IsAllInNodesSeen(
     }
     auto node = out_anchor->GetOwnerNode();
     GE_CHK_BOOL_EXEC(node != nullptr, continue, "GetOwnerNode is nullptr");
-    if ((node->GetType() == NEXTITERATION) || (node->GetType() == REFNEXTITERATION)) {
+    if ((node->GetTypeRef() == NEXTITERATION) || (node->GetTypeRef() == REFNEXTITERATION)) {
       continue;
     }
     if (nodes_seen.count(node.get()) == 0) {
@@ -590,7 +607,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool Node::IsAllInNodesSeen(
       GE_CHK_BOOL_EXEC(out_control_anchor != nullptr, continue, "out_control_anchor is nullptr");
       auto node = out_control_anchor->GetOwnerNode();
       GE_CHK_BOOL_EXEC(node != nullptr, continue, "GetOwnerNode is nullptr");
-      if ((node->GetType() == NEXTITERATION) || (node->GetType() == REFNEXTITERATION)) {
+      if ((node->GetTypeRef() == NEXTITERATION) || (node->GetTypeRef() == REFNEXTITERATION)) {
         continue;
       }
       if (nodes_seen.count(node.get()) == 0) {
@@ -766,8 +783,8 @@ graphStatus Node::Verify() const {
     for (const auto &in_anchor_ptr : GetAllInDataAnchors()) {
       GE_IF_BOOL_EXEC(in_anchor_ptr == nullptr, GELOGW("in anchor ptr is null");
                       continue);
-      bool valid_anchor = op_->GetType() == data_type || op_->GetType() == aipp_data_type ||
-          op_->GetType() == const_type || op_->GetType() == variable_type ||
+      bool valid_anchor = op_->GetTypeRef() == data_type || op_->GetTypeRef() == aipp_data_type ||
+          op_->GetTypeRef() == const_type || op_->GetTypeRef() == variable_type ||
           op_->IsOptionalInput(in_anchor_ptr->GetIdx()) || op_->MutableInputDesc(in_anchor_ptr->GetIdx()) == nullptr ||
           in_anchor_ptr->GetPeerAnchors().size() > 0;
       if (!valid_anchor) {
@@ -780,7 +797,7 @@ graphStatus Node::Verify() const {
   }
 
   string frameworkop_type = "FrameworkOp";
-  bool need_update_name = op_->GetType() != frameworkop_type && !is_unknown_graph;
+  bool need_update_name = op_->GetTypeRef() != frameworkop_type && !is_unknown_graph;
   if (need_update_name) {
     auto node_op = ge::OperatorFactoryImpl::CreateOperator("node_op", op_->GetType());
     if (node_op.IsEmpty()) {
@@ -15,6 +15,7 @@
  */
 
 #include "graph/op_desc.h"
+#include <algorithm>
 #include "debug/ge_attr_define.h"
 #include "debug/ge_util.h"
 #include "external/graph/operator.h"
@@ -69,6 +70,13 @@ const std::string ATTR_NAME_OP_INFER_DEPENDS = "_op_infer_depends";
 
 const std::string ATTR_NAME_OP_KERNEL_LIB_NAME = "_ge_attr_op_kernel_lib_name";
 
+namespace {
+// Same check as MutableInputDesc, without the warning for each invalid optional input
+bool IsValidTensorDesc(const GeTensorDescPtr &tensor_desc) {
+  return (tensor_desc != nullptr) && (tensor_desc->IsValid() == GRAPH_SUCCESS);
+}
+}  // namespace
+
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY OpDesc::OpDesc() {
   op_def_.InitDefault();
   if (op_def_.GetProtoMsg() != nullptr) {
@@ -90,6 +98,9 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY OpDesc::OpDesc(const std::string
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY OpDesc::OpDesc(const ProtoMsgOwner &proto_msg_owner,
                                                               ge::proto::OpDef *op_def)
     : op_def_(proto_msg_owner, op_def) {
+  if (op_def != nullptr) {
+    type_id_ = OpTypeUtils::GetOpTypeId(op_def->type());
+  }
   if (op_def != nullptr && !op_def->has_out_attr()) {
     op_def->set_has_out_attr(true);
 
@@ -189,7 +200,26 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void OpDesc::SetType(const string
   auto proto_msg = op_def_.GetProtoMsg();
   if (proto_msg != nullptr) {
     proto_msg->set_type(type);
+    type_id_ = OpTypeUtils::GetOpTypeId(type);
+  }
+}
+
+GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY const string &OpDesc::GetNameRef() const {
+  static const string empty_name;
+  auto proto_msg = op_def_.GetProtoMsg();
+  if (proto_msg != nullptr) {
+    return proto_msg->name();
   }
+  return empty_name;
+}
+
+GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY const string &OpDesc::GetTypeRef() const {
+  static const string empty_type;
+  auto proto_msg = op_def_.GetProtoMsg();
+  if (proto_msg != nullptr) {
+    return proto_msg->type();
+  }
+  return empty_type;
 }
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus OpDesc::AddInputDesc(const ge::GeTensorDesc &input_desc) {
@@ -223,6 +253,7 @@ graphStatus OpDesc::AddInputDesc(const string &name, const ge::GeTensorDesc &inp
     }
     inputs_desc_.push_back(in_desc);
     (void)input_name_idx_.insert(make_pair(name, index));
+    AppendIdxNameCache(input_idx_name_, static_cast<uint32_t>(index), name);
     if (find(register_input_name_.begin(), register_input_name_.end(), name) == register_input_name_.end()) {
       register_input_name_.push_back(name);
     }
@@ -232,6 +263,12 @@ graphStatus OpDesc::AddInputDesc(const string &name, const ge::GeTensorDesc &inp
 }
 
 graphStatus OpDesc::AddInputDescMiddle(const string &name, const unsigned int num, size_t index) {
+  if (index > inputs_desc_.size()) {
+    GELOGE(GRAPH_FAILED, "AddInputDescMiddle failed, insert index should not more than inputs size.");
+    return GRAPH_FAILED;
+  }
+  vector<GeTensorDescPtr> new_descs;
+  new_descs.reserve(num);
   for (unsigned int i = 0; i < num; i++) {
     string input_name = name + std::to_string(i);
     GE_CHK_BOOL_RET_STATUS((input_name_idx_.find(input_name) == input_name_idx_.end()), GRAPH_FAILED,
@@ -242,55 +279,55 @@ graphStatus OpDesc::AddInputDescMiddle(const string &name, const unsigned int nu
       GELOGE(GRAPH_FAILED, "AddInputDescMiddle failed, malloc shared_ptr failed.");
       return GRAPH_FAILED;
     }
+    new_descs.push_back(in_desc);
+  }
+  (void)inputs_desc_.insert(inputs_desc_.begin() + index, new_descs.begin(), new_descs.end());
 
-    if (index > inputs_desc_.size()) {
-      GELOGE(GRAPH_FAILED, "AddInputDescMiddle failed, insert index should not more than inputs size.");
-      return GRAPH_FAILED;
-    }
-
-    (void)inputs_desc_.insert(inputs_desc_.begin() + index + i, in_desc);
-
-    // Update index in input_name_idx
-    for (auto it = input_name_idx_.begin(); it != input_name_idx_.end(); ++it) {
-      if (it->second >= (index + i)) {
-        it->second += 1;
-      }
+  // Update index in input_name_idx once for all inserted tensors
+  for (auto it = input_name_idx_.begin(); it != input_name_idx_.end(); ++it) {
+    if (it->second >= index) {
+      it->second += num;
     }
-
-    (void)input_name_idx_.insert(make_pair(input_name, i + index));
   }
+  for (unsigned int i = 0; i < num; i++) {
+    (void)input_name_idx_.insert(make_pair(name + std::to_string(i), i + index));
+  }
+  ClearIdxNameCache();
 
   return GRAPH_SUCCESS;
 }
 
 graphStatus OpDesc::AddOutputDescMiddle(const string &name, const unsigned int num, size_t index) {
+  if (index > outputs_desc_.size()) {
+    GELOGE(GRAPH_FAILED, "AddOutputDescMiddle failed, insert index should not more than outputs size.");
+    return GRAPH_FAILED;
+  }
+  vector<GeTensorDescPtr> new_descs;
+  new_descs.reserve(num);
   for (unsigned int i = 0; i < num; i++) {
     string output_name = name + std::to_string(i);
     GE_CHK_BOOL_RET_STATUS((output_name_idx_.find(output_name) == output_name_idx_.end()), GRAPH_FAILED,
-                           "Add input tensor_desc is existed. name[%s]", output_name.c_str());
+                           "Add output tensor_desc is existed. name[%s]", output_name.c_str());
 
     std::shared_ptr<GeTensorDesc> out_desc = ComGraphMakeShared<GeTensorDesc>(GeTensorDesc());
     if (out_desc == nullptr) {
-      GELOGE(GRAPH_FAILED, "AddInputDescMiddle failed, malloc shared_ptr failed.");
+      GELOGE(GRAPH_FAILED, "AddOutputDescMiddle failed, malloc shared_ptr failed.");
       return GRAPH_FAILED;
     }
+    new_descs.push_back(out_desc);
+  }
+  (void)outputs_desc_.insert(outputs_desc_.begin() + index, new_descs.begin(), new_descs.end());
 
-    if (index > outputs_desc_.size()) {
-      GELOGE(GRAPH_FAILED, "AddInputDescMiddle failed, insert index should not more than inputs size.");
-      return GRAPH_FAILED;
-    }
-
-    (void)outputs_desc_.insert(outputs_desc_.begin() + index + i, out_desc);
-
-    // Update index in input_name_idx
-    for (auto it = output_name_idx_.begin(); it != output_name_idx_.end(); ++it) {
-      if (it->second >= (index + i)) {
-        it->second += 1;
-      }
+  // Update index in output_name_idx once for all inserted tensors
+  for (auto it = output_name_idx_.begin(); it != output_name_idx_.end(); ++it) {
+    if (it->second >= index) {
+      it->second += num;
     }
-
-    (void)output_name_idx_.insert(make_pair(output_name, i + index));
   }
+  for (unsigned int i = 0; i < num; i++) {
+    (void)output_name_idx_.insert(make_pair(name + std::to_string(i), i + index));
+  }
+  ClearIdxNameCache();
 
   return GRAPH_SUCCESS;
 }
@@ -315,6 +352,7 @@ graphStatus OpDesc::AddInputDescForward(const string &name, const unsigned int n
 
     (void)input_name_idx_.insert(make_pair(input_name, 0));
   }
+  ClearIdxNameCache();
 
   return GRAPH_SUCCESS;
 }
@@ -339,6 +377,7 @@ graphStatus OpDesc::AddOutputDescForward(const string &name, const unsigned int
     }
     (void)output_name_idx_.insert(make_pair(output_name, 0));
   }
+  ClearIdxNameCache();
 
   return GRAPH_SUCCESS;
 }
@@ -504,9 +543,8 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeTensorDescPtr OpDesc::MutableIn
 }
 
 GeTensorDescPtr OpDesc::MutableInputDesc(const string &name) const {
-  auto input_name_idx = GetAllInputName();
-  auto it = input_name_idx.find(name);
-  if (it == input_name_idx.end()) {
+  auto it = input_name_idx_.find(name);
+  if (it == input_name_idx_.end()) {
     GELOGW("Failed to get [%s] input desc", name.c_str());
     return nullptr;
   }
@@ -603,6 +641,7 @@ graphStatus OpDesc::AddOutputDesc(const string &name, const ge::GeTensorDesc &ou
   }
   outputs_desc_.push_back(tensor);
   (void)output_name_idx_.insert(make_pair(name, index));
+  AppendIdxNameCache(output_idx_name_, static_cast<uint32_t>(index), name);
   if (find(register_output_name_.begin(), register_output_name_.end(), name) == register_output_name_.end()) {
     register_output_name_.push_back(name);
   }
@@ -786,9 +825,15 @@ std::map<string, uint32_t> OpDesc::GetAllInputName() const { return input_name_i
 
 std::map<string, uint32_t> OpDesc::GetAllOutputName() { return output_name_idx_; }
 
-std::map<string, uint32_t>& OpDesc::MutableAllInputName() { return input_name_idx_; }
+std::map<string, uint32_t>& OpDesc::MutableAllInputName() {
+  ClearIdxNameCache();
+  return input_name_idx_;
+}
 
-std::map<string, uint32_t>& OpDesc::MutableAllOutputName() { return output_name_idx_; }
+std::map<string, uint32_t>& OpDesc::MutableAllOutputName() {
+  ClearIdxNameCache();
+  return output_name_idx_;
+}
 
 bool OpDesc::UpdateInputName(std::map<string, uint32_t> input_name_idx) {
   bool ret = true;
@@ -810,12 +855,14 @@ bool OpDesc::UpdateInputName(std::map<string, uint32_t> input_name_idx) {
     if (input_name_idx.size() == input_map_size) {
       GELOGI("UpdateInputName");
       input_name_idx_ = input_name_idx;
+      ClearIdxNameCache();
     } else {
       ret = false;
       GELOGW("after UpdateInputName factoryName map size : %zu", input_name_idx.size());
     }
   } else if (input_map_size == factory_map_size) {
     input_name_idx_ = input_name_idx;
+    ClearIdxNameCache();
   } else {
     ret = false;
     GELOGW("org inputname map size: %zu, factory inputname map size: %zu", input_map_size, factory_map_size);
@@ -839,10 +886,12 @@ bool OpDesc::UpdateOutputName(std::map<string, uint32_t> output_name_idx) {
     if (output_name_idx.size() == output_map_size) {
       GELOGI("UpdateoutputName");
       output_name_idx_ = output_name_idx;
+      ClearIdxNameCache();
       return true;
     }
   } else if (output_map_size == factory_map_size) {
     output_name_idx_ = output_name_idx;
+    ClearIdxNameCache();
     return true;
   } else {
     GELOGW("UpdateOutputName org name map size: %zu, factory map size: %zu", output_map_size, factory_map_size);
@@ -960,15 +1009,49 @@ graphStatus OpDesc::CommonVerify() const {
   return GRAPH_SUCCESS;
 }
 
-GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY string OpDesc::GetInputNameByIndex(uint32_t index) const {
-  auto it = input_name_idx_.begin();
-  for (; it != input_name_idx_.end(); ++it) {
-    if (it->second == index) {
-      break;
+void OpDesc::ClearIdxNameCache() {
+  input_idx_name_.reset();
+  output_idx_name_.reset();
+}
+
+void OpDesc::AppendIdxNameCache(std::shared_ptr<vector<string>> &idx_name, uint32_t index, const string &name) {
+  // A cache shared with a copied op desc is published already, so it is dropped instead of changed
+  if ((idx_name != nullptr) && (idx_name.use_count() == 1) && (idx_name->size() == static_cast<size_t>(index))) {
+    idx_name->push_back(name);
+  } else {
+    idx_name.reset();
+  }
+}
+
+std::shared_ptr<const vector<string>> OpDesc::GetIdxNameCache(const map<string, uint32_t> &name_idx,
+                                                              std::shared_ptr<vector<string>> &idx_name) {
+  std::shared_ptr<vector<string>> cache = std::atomic_load(&idx_name);
+  if (cache != nullptr) {
+    return cache;
+  }
+  uint32_t max_index = 0;
+  for (const auto &it : name_idx) {
+    max_index = std::max(max_index, it.second + 1);
+  }
+  cache = ComGraphMakeShared<vector<string>>(max_index, "");
+  if (cache == nullptr) {
+    GELOGE(GRAPH_FAILED, "Failed to create index to name cache.");
+    return nullptr;
+  }
+  // If several names share one index, keep the first one in name order as the old linear search did
+  for (const auto &it : name_idx) {
+    if ((*cache)[it.second].empty()) {
+      (*cache)[it.second] = it.first;
     }
   }
-  GE_CHK_BOOL_RET_STATUS_NOLOG(it != input_name_idx_.end(), "");
-  return it->first;
+  std::atomic_store(&idx_name, cache);
+  return cache;
+}
+
+GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY string OpDesc::GetInputNameByIndex(uint32_t index) const {
+  auto idx_name = GetIdxNameCache(input_name_idx_, input_idx_name_);
+  GE_CHK_BOOL_RET_STATUS_NOLOG((idx_name != nullptr) && (index < idx_name->size()), "");
+  return (*idx_name)[index];
 }
 
 int OpDesc::GetInputIndexByName(const string &name) const {
@@ -978,51 +1061,44 @@ int OpDesc::GetInputIndexByName(const string &name) const {
 }
 
 int OpDesc::GetValidInputIndexByName(const string &name) const {
-  map<string, uint32_t> valid_input_name_idx{};
-  uint32_t j = 0;
-  for (size_t i = 0; i < GetAllInputsSize(); i++) {
-    if (MutableInputDesc(static_cast<uint32_t>(i)) != nullptr) {
-      auto valid_name = GetInputNameByIndex(static_cast<uint32_t>(i));
-      GE_CHK_BOOL_RET_STATUS_NOLOG(!valid_name.empty(), -1);
-      valid_input_name_idx.insert({valid_name, j});
-      j++;
-    }
-  }
-  auto it_find = valid_input_name_idx.find(name);
-  GE_CHK_BOOL_RET_STATUS_NOLOG(it_find != valid_input_name_idx.end(), -1);
-  return static_cast<int>(it_find->second);
+  auto it_find = input_name_idx_.find(name);
+  GE_CHK_BOOL_RET_STATUS_NOLOG(it_find != input_name_idx_.end(), -1);
+  GE_CHK_BOOL_RET_STATUS_NOLOG(it_find->second < inputs_desc_.size(), -1);
+  GE_CHK_BOOL_RET_STATUS_NOLOG(IsValidTensorDesc(inputs_desc_[it_find->second]), -1);
+  // Validity lives in the tensor descs which may be changed through pointers, so it is counted instead of cached
+  auto idx_name = GetIdxNameCache(input_name_idx_, input_idx_name_);
+  GE_CHK_BOOL_RET_STATUS_NOLOG(idx_name != nullptr, -1);
+  int valid_index = 0;
+  for (uint32_t i = 0; i < it_find->second; i++) {
+    if (IsValidTensorDesc(inputs_desc_[i])) {
+      GE_CHK_BOOL_RET_STATUS_NOLOG((i < idx_name->size()) && !(*idx_name)[i].empty(), -1);
+      valid_index++;
+    }
+  }
+  return valid_index;
 }
 
 string OpDesc::GetValidInputNameByIndex(uint32_t index) const {
-  map<string, uint32_t> valid_input_name_idx{};
-  uint32_t j = 0;
-  for (size_t i = 0; i < GetAllInputsSize(); i++) {
-    if (MutableInputDesc(static_cast<uint32_t>(i)) != nullptr) {
-      auto valid_name = GetInputNameByIndex(static_cast<uint32_t>(i));
-      GE_CHK_BOOL_RET_STATUS_NOLOG(!valid_name.empty(), "");
-      valid_input_name_idx.insert({valid_name, j});
-      j++;
-    }
-  }
-  auto it = valid_input_name_idx.begin();
-  for (; it != valid_input_name_idx.end(); ++it) {
-    if (it->second == index) {
-      break;
+  auto idx_name = GetIdxNameCache(input_name_idx_, input_idx_name_);
+  GE_CHK_BOOL_RET_STATUS_NOLOG(idx_name != nullptr, "");
+  uint32_t valid_index = 0;
+  for (uint32_t i = 0; i < inputs_desc_.size(); i++) {
+    if (!IsValidTensorDesc(inputs_desc_[i])) {
+      continue;
+    }
+    GE_CHK_BOOL_RET_STATUS_NOLOG((i < idx_name->size()) && !(*idx_name)[i].empty(), "");
+    if (valid_index == index) {
+      return (*idx_name)[i];
     }
+    valid_index++;
   }
-  GE_CHK_BOOL_RET_STATUS_NOLOG(it != valid_input_name_idx.end(), "");
-  return it->first;
+  return "";
 }
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY string OpDesc::GetOutputNameByIndex(uint32_t index) const {
-  auto it = output_name_idx_.begin();
-  for (; it != output_name_idx_.end(); ++it) {
-    if (it->second == index) {
-      break;
-    }
-  }
-  GE_CHK_BOOL_RET_STATUS_NOLOG(it != output_name_idx_.end(), "");
-  return it->first;
+  auto idx_name = GetIdxNameCache(output_name_idx_, output_idx_name_);
+  GE_CHK_BOOL_RET_STATUS_NOLOG((idx_name != nullptr) && (index < idx_name->size()), "");
+  return (*idx_name)[index];
 }
 
 int OpDesc::GetOutputIndexByName(const string &name) const {
@@ -1307,6 +1383,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus OpDesc::RestoreInputN
     GELOGI("Restore input name index is existed. name[%s]", name.c_str());
   }
   (void)input_name_idx_.insert(make_pair(name, index));
+  ClearIdxNameCache();
   return GRAPH_SUCCESS;
 }
 
@@ -1316,6 +1393,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus OpDesc::RestoreOutput
     GELOGI("Restore output name index is existed. name[%s]", name.c_str());
   }
   (void)output_name_idx_.insert(make_pair(name, index));
+  ClearIdxNameCache();
   return GRAPH_SUCCESS;
 }
 graphStatus OpDesc::CallInferFunc(Operator &op) {
@@ -1326,12 +1404,8 @@ graphStatus OpDesc::CallInferFunc(Operator &op) {
       return GRAPH_PARAM_INVALID;
     }
   }
-  std::unique_ptr<NodeShapeTransUtils> transformer(new(std::nothrow) NodeShapeTransUtils(shared_from_this()));
-  if (transformer == nullptr) {
-    GELOGE(GRAPH_FAILED, "Memory alloc failed");
-    return GRAPH_FAILED;
-  }
-  if (!transformer->CatchFormatAndShape()) {
+  NodeShapeTransUtils transformer(shared_from_this());
+  if (!transformer.CatchFormatAndShape()) {
     GELOGE(GRAPH_FAILED, "catch format and shape info failed!");
     return GRAPH_FAILED;
   }
@@ -1340,7 +1414,7 @@ graphStatus OpDesc::CallInferFunc(Operator &op) {
     GELOGE(GRAPH_FAILED, "%s call infer func. ret: %u", GetName().c_str(), graph_status);
     return GRAPH_FAILED;
   }
-  if (!transformer->UpdateFormatAndShape()) {
+  if (!transformer.UpdateFormatAndShape()) {
     GELOGE(GRAPH_FAILED, "catch format and shape info failed!");
     return GRAPH_FAILED;
   }
@@ -140,12 +140,10 @@ class OperatorImpl : public std::enable_shared_from_this<OperatorImpl> {
     string src_name = src_op_impl->op_desc_->GetOutputNameByIndex(src_index);
     GE_CHK_BOOL_EXEC(!src_name.empty(), return, "Src output's name is empty.");
 
-    OpIO out_handler(src_name, src_index, src_op_impl);
-    input_link_.insert(std::make_pair(dst_name, out_handler));
-
     int dst_index = op_desc_->GetInputIndexByName(dst_name);
     GE_CHK_BOOL_EXEC(dst_index >= 0, return, "Find input index by name failed. name[%s], op name:%s", dst_name.c_str(),
                      op_desc_->GetName().c_str());
+    SetInputLink(static_cast<uint32_t>(dst_index), src_op_impl, src_index);
 
     bool is_const = false;
     if (src_oprt.GetOpType() == CONSTANT) {
@@ -159,17 +157,16 @@ class OperatorImpl : public std::enable_shared_from_this<OperatorImpl> {
     is_input_const[dst_index] = is_const;
     op_desc_->SetIsInputConst(is_input_const);
 
-    OpIO op_dst(dst_name, dst_index, shared_from_this());
-    src_op_impl->UpdateLinkMapImpl(src_name, op_dst);
-    auto output_desc = src_op_impl->GetOutputDesc(src_name);
-    auto input_desc = op_desc_->GetInputDesc(dst_name);
+    src_op_impl->AddOutputLink(src_index, shared_from_this(), static_cast<uint32_t>(dst_index));
+    auto output_desc = src_op_impl->GetOutputDesc(src_index);
+    auto input_desc = op_desc_->GetInputDesc(static_cast<uint32_t>(dst_index));
     if (input_desc.GetFormat() == FORMAT_RESERVED) {
       output_desc.SetFormat(FORMAT_ND);
     } else {
       output_desc.SetFormat(input_desc.GetFormat());
     }
     // Fix for linking opdesc
-    if (op_desc_->UpdateInputDesc(dst_name, output_desc) != GRAPH_SUCCESS) {
+    if (op_desc_->UpdateInputDesc(static_cast<uint32_t>(dst_index), output_desc) != GRAPH_SUCCESS) {
       GELOGE(GRAPH_FAILED, "Update inputdesc failed,dst name is %s, src name is %s", dst_name.c_str(),
              src_name.c_str());
       return;
@@ -180,7 +177,6 @@ class OperatorImpl : public std::enable_shared_from_this<OperatorImpl> {
     GE_CHK_BOOL_EXEC(!dst_name.empty(), return, "dst name is empty");
     GE_CHK_BOOL_EXEC(out_handler != nullptr, return, "SetInputImpl faild, out_handler is nullptr.");
     GE_CHK_BOOL_EXEC(op_desc_ != nullptr, return, "op_desc_ is nullptr.");
-    input_link_.insert(std::make_pair(dst_name, *out_handler));
 
     string src_name = out_handler->GetName();
     int dst_index = op_desc_->GetInputIndexByName(dst_name);
@@ -189,8 +185,12 @@ class OperatorImpl : public std::enable_shared_from_this<OperatorImpl> {
     auto out_op_impl = out_handler->GetOwner();
     GE_CHK_BOOL_EXEC(out_op_impl != nullptr && out_op_impl->GetOpDescImpl() != nullptr, return,
                      "out_handler invalid. name[%s]", dst_name.c_str());
+    GE_CHK_BOOL_EXEC(out_handler->GetIndex() >= 0, return, "out_handler invalid. name[%s], index[%d]",
+                     src_name.c_str(), out_handler->GetIndex());
+    auto src_index = static_cast<uint32_t>(out_handler->GetIndex());
+    SetInputLink(static_cast<uint32_t>(dst_index), out_op_impl, src_index);
     bool is_const = false;
-    if (out_op_impl->GetOpDescImpl()->GetType() == CONSTANT) {
+    if (out_op_impl->GetOpDescImpl()->GetTypeRef() == CONSTANT) {
       is_const = true;
     }
     auto is_input_const = op_desc_->GetIsInputConst();
@@ -200,18 +200,16 @@ class OperatorImpl : public std::enable_shared_from_this<OperatorImpl> {
     is_input_const[dst_index] = is_const;
     op_desc_->SetIsInputConst(is_input_const);
 
-    OpIO in_handler(dst_name, dst_index, shared_from_this());
-    GE_CHK_BOOL_EXEC(out_op_impl != nullptr, return, "Get out_handler's impl failed.");
-
-    out_op_impl->UpdateLinkMapImpl(src_name, in_handler);
-    auto src_output_desc = out_op_impl->GetOutputDesc(src_name);
-    auto dst_input_desc = op_desc_->GetInputDesc(dst_name);
+    out_op_impl->AddOutputLink(src_index, shared_from_this(), static_cast<uint32_t>(dst_index));
+    auto src_output_desc = out_op_impl->GetOutputDesc(src_index);
+    auto dst_input_desc = op_desc_->GetInputDesc(static_cast<uint32_t>(dst_index));
     if (dst_input_desc.GetFormat() == FORMAT_RESERVED) {
       src_output_desc.SetFormat(FORMAT_ND);
     } else {
       src_output_desc.SetFormat(dst_input_desc.GetFormat());
     }
-    GE_CHK_BOOL_EXEC(op_desc_->UpdateInputDesc(dst_name, src_output_desc) == GRAPH_SUCCESS, return,
+    GE_CHK_BOOL_EXEC(op_desc_->UpdateInputDesc(static_cast<uint32_t>(dst_index), src_output_desc) == GRAPH_SUCCESS,
+                     return,
                      "Update input desc failed,dst name is %s,src name is %s", dst_name.c_str(),
                      src_name.c_str()); // fix for linking opdesc
   }
@@ -231,11 +229,16 @@ class OperatorImpl : public std::enable_shared_from_this<OperatorImpl> {
   }
 
   graphStatus GetInputImpl(const string &dst_name, ge::OpIO &out_handler) {
-    auto out = input_link_.find(dst_name);
-    if (out == input_link_.end()) {
+    GE_CHK_BOOL_RET_STATUS(op_desc_ != nullptr, GRAPH_FAILED, "op_desc_ is nullptr.");
+    int dst_index = op_desc_->GetInputIndexByName(dst_name);
+    if ((dst_index < 0) || (static_cast<size_t>(dst_index) >= input_links_.size())) {
       return GRAPH_FAILED;
     }
-    out_handler = out->second;
+    const auto &src = input_links_[dst_index];
+    if ((src.owner == nullptr) || (src.owner->op_desc_ == nullptr)) {
+      return GRAPH_FAILED;
+    }
+    out_handler = OpIO(src.owner->op_desc_->GetOutputNameByIndex(src.index), static_cast<int>(src.index), src.owner);
     return GRAPH_SUCCESS;
   }
 
@@ -262,11 +265,11 @@ class OperatorImpl : public std::enable_shared_from_this<OperatorImpl> {
         return const_op.GetAttr(ATTR_NAME_WEIGHTS, data);
       } else if (peer_op_type == DATA) {
         auto parent_node = NodeUtils::GetParentInput(peer_node);
-        while ((parent_node != nullptr) && (parent_node->GetType() == DATA)) {
+        while ((parent_node != nullptr) && (parent_node->GetTypeRef() == DATA)) {
           parent_node = NodeUtils::GetParentInput(parent_node);
         }
         if ((parent_node != nullptr)
-            && ((parent_node->GetType() == CONSTANT) || (parent_node->GetType() == CONSTANTOP))) {
+            && ((parent_node->GetTypeRef() == CONSTANT) || (parent_node->GetTypeRef() == CONSTANTOP))) {
           auto const_op_impl = ComGraphMakeShared<OperatorImpl>(parent_node);
           GE_CHECK_NOTNULL(const_op_impl);
           Operator const_op(std::move(const_op_impl));
@@ -274,10 +277,10 @@ class OperatorImpl : public std::enable_shared_from_this<OperatorImpl> {
         }
       }
       // Try get from runtime inference context
-      auto session_id = std::to_string(GetContext().SessionId());
+      auto session_id = GetContext().SessionId();
       RuntimeInferenceContext *runtime_infer_ctx = nullptr;
       if (RuntimeInferenceContext::GetContext(session_id, &runtime_infer_ctx) == GRAPH_SUCCESS) {
-        GELOGD("To get constant from runtime inference context. session_id = %s", session_id.c_str());
+        GELOGD("To get constant from runtime inference context. session_id = %lu", session_id);
         auto ret = runtime_infer_ctx->GetTensor(peer_node->GetOpDesc()->GetId(), out_data_anchor->GetIdx(), data);
         if (ret == GRAPH_SUCCESS) {
           return GRAPH_SUCCESS;
@@ -330,6 +333,35 @@ class OperatorImpl : public std::enable_shared_from_this<OperatorImpl> {
     return op_desc_->GetInputDesc(index);
   }
 
+  // The Get*TensorDesc functions convert the tensor desc held by op desc in place, without copying it first
+  TensorDesc GetInputTensorDesc(const string &name) const {
+    GE_CHK_BOOL_EXEC(op_desc_ != nullptr, return ToTensorDesc(nullptr), "op_desc_ is nullptr.");
+    auto it = op_desc_->input_name_idx_.find(name);
+    if (it == op_desc_->input_name_idx_.end()) {
+      return ToTensorDesc(nullptr);
+    }
+    return GetInputTensorDesc(it->second);
+  }
+
+  TensorDesc GetInputTensorDesc(uint32_t index) const {
+    GE_CHK_BOOL_EXEC(op_desc_ != nullptr, return ToTensorDesc(nullptr), "op_desc_ is nullptr.");
+    return ToTensorDesc((index < op_desc_->inputs_desc_.size()) ? op_desc_->inputs_desc_[index].get() : nullptr);
+  }
+
+  TensorDesc GetOutputTensorDesc(const string &name) const {
+    GE_CHK_BOOL_EXEC(op_desc_ != nullptr, return ToTensorDesc(nullptr), "op_desc_ is nullptr.");
+    auto it = op_desc_->output_name_idx_.find(name);
+    if (it == op_desc_->output_name_idx_.end()) {
+      return ToTensorDesc(nullptr);
+    }
+    return GetOutputTensorDesc(it->second);
+  }
+
+  TensorDesc GetOutputTensorDesc(uint32_t index) const {
+    GE_CHK_BOOL_EXEC(op_desc_ != nullptr, return ToTensorDesc(nullptr), "op_desc_ is nullptr.");
+    return ToTensorDesc((index < op_desc_->outputs_desc_.size()) ? op_desc_->outputs_desc_[index].get() : nullptr);
+  }
+
   graphStatus UpdateInputDesc(const string &name, const GeTensorDesc &tensor_desc) {
     GE_CHK_BOOL_EXEC(op_desc_ != nullptr, return GRAPH_FAILED, "op_desc_ is nullptr.");
 
@@ -381,14 +413,15 @@ class OperatorImpl : public std::enable_shared_from_this<OperatorImpl> {
     GE_CHK_BOOL_RET_STATUS(op_desc_ != nullptr, GRAPH_FAILED, "op_desc is nullptr.");
 
     auto res = op_desc_->UpdateOutputDesc(name, tensor_desc);
-    if (res == GRAPH_SUCCESS) {
-      for (auto ol : output_links_[name]) {
-        if (ol.GetOwner() == nullptr) {
-          GELOGW("%s get owner is nullptr", ol.GetName().c_str());
+    int src_index = op_desc_->GetOutputIndexByName(name);
+    if ((res == GRAPH_SUCCESS) && (src_index >= 0) && (static_cast<size_t>(src_index) < output_links_.size())) {
+      for (const auto &dst : output_links_[src_index]) {
+        if ((dst.owner == nullptr) || (dst.owner->op_desc_ == nullptr)) {
+          GELOGW("%s output %d get owner is nullptr", name.c_str(), src_index);
           continue;
         }
-        GE_CHK_BOOL_RET_STATUS(ol.GetOwner()->UpdateInputDesc(ol.GetName(), tensor_desc) == GRAPH_SUCCESS, GRAPH_FAILED,
-                               "Could not update next operator's input %s.", ol.GetName().c_str());
+        GE_CHK_BOOL_RET_STATUS(dst.owner->op_desc_->UpdateInputDesc(dst.index, tensor_desc) == GRAPH_SUCCESS,
+                               GRAPH_FAILED, "Could not update next operator's input %u.", dst.index);
       }
     }
     return res;
@@ -416,14 +449,62 @@ class OperatorImpl : public std::enable_shared_from_this<OperatorImpl> {
 
   OpDescPtr GetOpDescImpl() const { return op_desc_; }
 
-  void UpdateLinkMapImpl(const string &src_name, OpIO &op_dst) {
-    auto it_find = output_links_.find(src_name);
-    if (it_find == output_links_.end()) {
-      std::vector<OpIO> dsts{op_dst};
-      output_links_.insert(std::make_pair(src_name, dsts));
-    } else {
-      it_find->second.push_back(op_dst);
+  void AddOutputLink(uint32_t src_index, const OperatorImplPtr &dst, uint32_t dst_index) {
+    if (src_index >= output_links_.size()) {
+      output_links_.resize(src_index + 1);
+    }
+    output_links_[src_index].push_back({dst, dst_index});
+  }
+
+  // the first link of an input is kept, as SetInput does not relink an input already set
+  void SetInputLink(uint32_t dst_index, const OperatorImplPtr &src, uint32_t src_index) {
+    if (dst_index >= input_links_.size()) {
+      input_links_.resize(dst_index + 1);
+    }
+    if (input_links_[dst_index].owner == nullptr) {
+      input_links_[dst_index] = {src, src_index};
+    }
+  }
+
+  // num input descs are inserted at index, links of the inputs behind move with them, peers included
+  void ShiftInputLinks(uint32_t index, uint32_t num) {
+    if ((num == 0) || (index >= input_links_.size())) {
+      return;
+    }
+    // from the last input, so a moved index never collides with one not moved yet
+    for (size_t i = input_links_.size(); i > index; --i) {
+      auto old_index = static_cast<uint32_t>(i - 1);
+      const auto &src = input_links_[old_index];
+      if ((src.owner == nullptr) || (src.index >= src.owner->output_links_.size())) {
+        continue;
+      }
+      for (auto &dst : src.owner->output_links_[src.index]) {
+        if ((dst.owner.get() == this) && (dst.index == old_index)) {
+          dst.index = old_index + num;
+        }
+      }
+    }
+    (void)input_links_.insert(input_links_.begin() + index, num, LinkPeer{nullptr, 0});
+  }
+
+  // num output descs are inserted at index, links of the outputs behind move with them, peers included
+  void ShiftOutputLinks(uint32_t index, uint32_t num) {
+    if ((num == 0) || (index >= output_links_.size())) {
+      return;
+    }
+    for (size_t i = output_links_.size(); i > index; --i) {
+      auto old_index = static_cast<uint32_t>(i - 1);
+      for (const auto &dst : output_links_[old_index]) {
+        if ((dst.owner == nullptr) || (dst.index >= dst.owner->input_links_.size())) {
+          continue;
+        }
+        auto &src = dst.owner->input_links_[dst.index];
+        if ((src.owner.get() == this) && (src.index == old_index)) {
+          src.index = old_index + num;
+        }
+      }
     }
+    (void)output_links_.insert(output_links_.begin() + index, num, std::vector<LinkPeer>());
   }
 
   Operator ToOperator() { return Operator(shared_from_this()); }
@@ -435,7 +516,7 @@ class OperatorImpl : public std::enable_shared_from_this<OperatorImpl> {
 
   void ClearOutputLinks() noexcept { output_links_.clear(); }
 
-  void ClearInputLinks() noexcept { input_link_.clear(); }
+  void ClearInputLinks() noexcept { input_links_.clear(); }
 
   ge::ConstNodePtr GetNode() { return node_; }
 
@@ -508,10 +589,21 @@ class OperatorImpl : public std::enable_shared_from_this<OperatorImpl> {
   OpDescPtr op_desc_ = nullptr;
 
  private:
+  static TensorDesc ToTensorDesc(const GeTensorDesc *desc) {
+    return (desc == nullptr) ? TensorAdapter::GeTensorDesc2TensorDesc(GeTensorDesc())
+                             : TensorAdapter::GeTensorDesc2TensorDesc(*desc);
+  }
+
   ge::ConstNodePtr node_{nullptr};
   ge::InferenceContextPtr inference_context_;
-  std::map<string, std::vector<OpIO>> output_links_{};
-  std::map<string, OpIO> input_link_{};
+  // peer of a link, name of the port is got from op desc of owner by index when needed
+  struct LinkPeer {
+    OperatorImplPtr owner;
+    uint32_t index;
+  };
+  // indexed by output/input index, an input not linked has no owner
+  std::vector<std::vector<LinkPeer>> output_links_{};
+  std::vector<LinkPeer> input_links_{};
   std::vector<std::weak_ptr<OperatorImpl>> control_input_link_{};
   std::vector<std::weak_ptr<OperatorImpl>> control_output_link_{};
   std::map<std::string, SubgraphBuilder> subgraph_names_to_builders_;
@@ -600,6 +692,34 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY OpDescPtr OpDescUtils::GetOpDescF
   return OperatorImpl::GetOpDesc(oprt);
 }
 
+GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeTensorDescPtr OpDescUtils::MutableInputDesc(const Operator &oprt,
+                                                                                            const std::string &name) {
+  auto op_desc = OperatorImpl::GetOpDesc(oprt);
+  GE_CHK_BOOL_EXEC(op_desc != nullptr, return nullptr, "op_desc is nullptr.");
+  return op_desc->MutableInputDesc(name);
+}
+
+GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeTensorDescPtr OpDescUtils::MutableInputDesc(const Operator &oprt,
+                                                                                            uint32_t index) {
+  auto op_desc = OperatorImpl::GetOpDesc(oprt);
+  GE_CHK_BOOL_EXEC(op_desc != nullptr, return nullptr, "op_desc is nullptr.");
+  return op_desc->MutableInputDesc(index);
+}
+
+GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeTensorDescPtr OpDescUtils::MutableOutputDesc(const Operator &oprt,
+                                                                                             const std::string &name) {
+  auto op_desc = OperatorImpl::GetOpDesc(oprt);
+  GE_CHK_BOOL_EXEC(op_desc != nullptr, return nullptr, "op_desc is nullptr.");
+  return op_desc->MutableOutputDesc(name);
+}
+
+GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeTensorDescPtr OpDescUtils::MutableOutputDesc(const Operator &oprt,
+                                                                                             uint32_t index) {
+  auto op_desc = OperatorImpl::GetOpDesc(oprt);
+  GE_CHK_BOOL_EXEC(op_desc != nullptr, return nullptr, "op_desc is nullptr.");
+  return op_desc->MutableOutputDesc(index);
+}
+
 GE_FUNC_HOST_VISIBILITY Operator::Operator(const string &name, const string &type) {
   operator_impl_ = ComGraphMakeShared<OperatorImpl>(name, type);
   if (operator_impl_ == nullptr) {
@@ -766,14 +886,14 @@ std::shared_ptr<const Node>  Operator::GetNode() const {
 
 TensorDesc Operator::GetInputDesc(const std::string &name) const {
   GE_CHK_BOOL_EXEC(operator_impl_ != nullptr, return TensorDesc(), "operator impl is nullptr.");
-  return TensorAdapter::GeTensorDesc2TensorDesc(operator_impl_->GetInputDesc(name));
+  return operator_impl_->GetInputTensorDesc(name);
 }
 
 TensorDesc Operator::GetInputDesc(const char *name, uint32_t len) const {
   GE_CHK_BOOL_EXEC(name != nullptr, return TensorDesc(), "Operator name is nullptr.");
   std::string op_name = name;
   GE_CHK_BOOL_EXEC(operator_impl_ != nullptr, return TensorDesc(), "Operator impl is nullptr.");
-  return TensorAdapter::GeTensorDesc2TensorDesc(operator_impl_->GetInputDesc(op_name));
+  return operator_impl_->GetInputTensorDesc(op_name);
 }
 
 void Operator::SetInferenceContext(const InferenceContextPtr &inference_context) {
@@ -788,14 +908,14 @@ InferenceContextPtr Operator::GetInferenceContext() const {
 
 TensorDesc Operator::GetInputDesc(uint32_t index) const {
   GE_CHK_BOOL_EXEC(operator_impl_ != nullptr, return TensorDesc(), "operator impl is nullptr.");
-  return TensorAdapter::GeTensorDesc2TensorDesc(operator_impl_->GetInputDesc(index));
+  return operator_impl_->GetInputTensorDesc(index);
 }
 
 graphStatus Operator::TryGetInputDesc(const string &name, TensorDesc &tensor_desc) const {
   GE_CHK_BOOL_EXEC(operator_impl_ != nullptr, return GRAPH_FAILED, "operator impl is nullptr.");
   auto check = operator_impl_->InputIsSet(name);
   if (check)
-    tensor_desc = TensorAdapter::GeTensorDesc2TensorDesc(operator_impl_->GetInputDesc(name));
+    tensor_desc = operator_impl_->GetInputTensorDesc(name);
   return check ? GRAPH_SUCCESS : GRAPH_FAILED;
 }
 
@@ -805,7 +925,7 @@ graphStatus Operator::TryGetInputDesc(const char *name, TensorDesc &tensor_desc)
   std::string op_name = name;
   auto check = operator_impl_->InputIsSet(op_name);
   if (check)
-    tensor_desc = TensorAdapter::GeTensorDesc2TensorDesc(operator_impl_->GetInputDesc(op_name));
+    tensor_desc = operator_impl_->GetInputTensorDesc(op_name);
   return check ? GRAPH_SUCCESS : GRAPH_FAILED;
 }
 
@@ -833,19 +953,19 @@ OutHandler Operator::GetOutput(uint32_t index) const {
 
 TensorDesc Operator::GetOutputDesc(const std::string &name) const {
   GE_CHK_BOOL_EXEC(operator_impl_ != nullptr, return TensorDesc(), "operator impl is nullptr.");
-  return TensorAdapter::GeTensorDesc2TensorDesc(operator_impl_->GetOutputDesc(name));
+  return operator_impl_->GetOutputTensorDesc(name);
 }
 
 TensorDesc Operator::GetOutputDesc(const char *name, uint32_t len) const {
   GE_CHK_BOOL_EXEC(name != nullptr, return TensorDesc(), "Operator name is nullptr.");
   GE_CHK_BOOL_EXEC(operator_impl_ != nullptr, return TensorDesc(), "Operator impl is nullptr.");
   std::string op_name = name;
-  return TensorAdapter::GeTensorDesc2TensorDesc(operator_impl_->GetOutputDesc(op_name));
+  return operator_impl_->GetOutputTensorDesc(op_name);
 }
 
 TensorDesc Operator::GetOutputDesc(uint32_t index) const {
   GE_CHK_BOOL_EXEC(operator_impl_ != nullptr, return TensorDesc(), "operator impl is nullptr.");
-  return TensorAdapter::GeTensorDesc2TensorDesc(operator_impl_->GetOutputDesc(index));
+  return operator_impl_->GetOutputTensorDesc(index);
 }
 
 graphStatus Operator::UpdateOutputDesc(const std::string &name, const ge::TensorDesc &tensor_desc) {
@@ -862,14 +982,14 @@ graphStatus Operator::UpdateOutputDesc(const char *name, const ge::TensorDesc &t
 
 TensorDesc Operator::GetDynamicInputDesc(const string &name, uint32_t index) const {
   GE_CHK_BOOL_EXEC(operator_impl_ != nullptr, return TensorDesc(), "operator impl is nullptr.");
-  return TensorAdapter::GeTensorDesc2TensorDesc(operator_impl_->GetInputDesc(name + std::to_string(index)));
+  return operator_impl_->GetInputTensorDesc(name + std::to_string(index));
 }
 
 TensorDesc Operator::GetDynamicInputDesc(const char *name, uint32_t index) const {
   GE_CHK_BOOL_EXEC(name != nullptr, return TensorDesc(), "Operator name is nullptr.");
   GE_CHK_BOOL_EXEC(operator_impl_ != nullptr, return TensorDesc(), "Operator impl is nullptr.");
   std::string op_name = name;
-  return TensorAdapter::GeTensorDesc2TensorDesc(operator_impl_->GetInputDesc(op_name + std::to_string(index)));
+  return operator_impl_->GetInputTensorDesc(op_name + std::to_string(index));
 }
 
 graphStatus Operator::UpdateDynamicInputDesc(const string &name, uint32_t index, const TensorDesc &tensor_desc) {
@@ -887,14 +1007,14 @@ graphStatus Operator::UpdateDynamicInputDesc(const char *name, uint32_t index, c
 
 TensorDesc Operator::GetDynamicOutputDesc(const string &name, uint32_t index) const {
   GE_CHK_BOOL_EXEC(operator_impl_ != nullptr, return TensorDesc(), "operator impl is nullptr.");
-  return TensorAdapter::GeTensorDesc2TensorDesc(operator_impl_->GetOutputDesc(name + std::to_string(index)));
+  return operator_impl_->GetOutputTensorDesc(name + std::to_string(index));
 }
 
 TensorDesc Operator::GetDynamicOutputDesc(const char *name, uint32_t index) const {
   GE_CHK_BOOL_EXEC(name != nullptr, return TensorDesc(), "Operator name is nullptr.");
   GE_CHK_BOOL_EXEC(operator_impl_ != nullptr, return TensorDesc(), "Operator impl is nullptr.");
   std::string op_name = name;
-  return TensorAdapter::GeTensorDesc2TensorDesc(operator_impl_->GetOutputDesc(op_name + std::to_string(index)));
+  return operator_impl_->GetOutputTensorDesc(op_name + std::to_string(index));
 }
 
 graphStatus Operator::UpdateDynamicOutputDesc(const string &name, uint32_t index, const TensorDesc &tensor_desc) {
@@ -1059,13 +1179,20 @@ void Operator::DynamicInputRegister(const string &name, const unsigned int num,
   GE_CHK_BOOL_EXEC(operator_impl_->GetOpDescImpl() != nullptr, return, "GetOpDescImpl is nullptr.");
   GE_CHK_BOOL_EXEC(AttrUtils::SetInt(operator_impl_->GetOpDescImpl(), DYNAMIC_INPUT_TD_NUM(name), num), return,
                    "set int failed");
+  auto input_num = operator_impl_->GetOpDescImpl()->GetAllInputsSize();
   (void)operator_impl_->GetOpDescImpl()->AddDynamicInputDesc(name, num, is_push_back);
+  if (!is_push_back) {
+    operator_impl_->ShiftInputLinks(0, static_cast<uint32_t>(operator_impl_->GetOpDescImpl()->GetAllInputsSize() -
+                                                             input_num));
+  }
 }
 
 void Operator::DynamicInputRegisterByIndex(const string &name, const unsigned int num, size_t index) {
   GE_CHK_BOOL_EXEC(!!operator_impl_, return, "operator impl is nullptr.");
   GE_CHK_BOOL_EXEC(nullptr != operator_impl_->GetOpDescImpl(), return, "GetOpDescImpl is nullptr.");
-  operator_impl_->GetOpDescImpl()->AddDynamicInputDescByIndex(name, num, index);
+  if (operator_impl_->GetOpDescImpl()->AddDynamicInputDescByIndex(name, num, index) == GRAPH_SUCCESS) {
+    operator_impl_->ShiftInputLinks(static_cast<uint32_t>(index), num);
+  }
 }
 
 int Operator::GetDynamicInputNum(const string &name) const {
@@ -1093,7 +1220,11 @@ void Operator::DynamicOutputRegister(const string &name, const unsigned int num,
   GE_CHK_BOOL_EXEC(operator_impl_->GetOpDescImpl() != nullptr, return, "GetOpDescImpl is nullptr.");
   GE_CHK_BOOL_EXEC(AttrUtils::SetInt(operator_impl_->GetOpDescImpl(), DYNAMIC_OUTPUT_TD_NUM(name), num), return,
                    "Set %s int failed", name.c_str());
+  auto output_num = operator_impl_->GetOpDescImpl()->GetAllOutputsDescSize();
   (void)operator_impl_->GetOpDescImpl()->AddDynamicOutputDesc(name, num, is_push_back);
+  if (!is_push_back) {
+    operator_impl_->ShiftOutputLinks(0, operator_impl_->GetOpDescImpl()->GetAllOutputsDescSize() - output_num);
+  }
 }
 
 int Operator::GetDynamicOutputNum(const string &name) const {
@@ -2087,8 +2218,8 @@ class GraphBuilderImpl {
         auto &out_links = op_impl->output_links_;
         std::vector<OperatorImplPtr> vec_op_forward{};
         for (const auto &out_link : out_links) {
-          for (const auto &op_forward : out_link.second) {
-            vec_op_forward.push_back(op_forward.GetOwner());
+          for (const auto &op_forward : out_link) {
+            vec_op_forward.push_back(op_forward.owner);
           }
         }
 
@@ -2098,10 +2229,12 @@ class GraphBuilderImpl {
         }
         que.push(vec_op_forward);
 
-        auto &in_links = op_impl->input_link_;
+        auto &in_links = op_impl->input_links_;
         std::vector<OperatorImplPtr> vec_op_back_forward{};
         for (const auto &in_link : in_links) {
-          vec_op_back_forward.push_back(in_link.second.GetOwner());
+          if (in_link.owner != nullptr) {
+            vec_op_back_forward.push_back(in_link.owner);
+          }
         }
 
         auto &in_control_links = op_impl->control_input_link_;
@@ -2182,25 +2315,25 @@ class GraphBuilderImpl {
       auto src_node_ptr = node_info.second;
 
       GE_IF_BOOL_EXEC(src_op_impl_ptr == nullptr || src_node_ptr == nullptr, continue);
-      auto out_links = src_op_impl_ptr->output_links_;
+      const auto &out_links = src_op_impl_ptr->output_links_;
       GE_CHK_BOOL_EXEC(src_op_impl_ptr->op_desc_ != nullptr, return GRAPH_FAILED,
                        "Src operator impl's op_desc is null.");
       auto &op_desc = src_op_impl_ptr->op_desc_;
       GE_IF_BOOL_EXEC(op_desc == nullptr, continue);
-      for (const auto &out : out_links) {
-        auto src_idx = op_desc->GetOutputIndexByName(out.first);
-        GE_CHK_BOOL_EXEC(src_idx >= 0, return GRAPH_FAILED, "Find output index by name failed");
-
-        auto src_anchor = src_node_ptr->GetOutDataAnchor(src_idx);
+      for (size_t src_idx = 0; src_idx < out_links.size(); ++src_idx) {
+        if (out_links[src_idx].empty()) {
+          continue;
+        }
+        auto src_anchor = src_node_ptr->GetOutDataAnchor(static_cast<int>(src_idx));
         GE_CHK_BOOL_EXEC(src_anchor != nullptr, return GRAPH_FAILED, "GetOutDataAnchor failed.");
 
-        for (const auto &dst_opio : out.second) {
-          auto dst_node_info = all_nodes_info_.find(dst_opio.GetOwner());
+        for (const auto &dst_opio : out_links[src_idx]) {
+          auto dst_node_info = all_nodes_info_.find(dst_opio.owner);
           GE_CHK_BOOL_EXEC(dst_node_info != all_nodes_info_.end(), return GRAPH_FAILED, "Find Dst node failed.");
 
           GE_IF_BOOL_EXEC(dst_node_info->second == nullptr, continue);
 
-          auto dst_anchor = dst_node_info->second->GetInDataAnchor(dst_opio.GetIndex());
+          auto dst_anchor = dst_node_info->second->GetInDataAnchor(static_cast<int>(dst_opio.index));
           GE_CHK_BOOL_EXEC(dst_anchor != nullptr, return GRAPH_FAILED, "GetInDataAnchor failed.");
 
           auto ret = GraphUtils::AddEdge(src_anchor, dst_anchor);
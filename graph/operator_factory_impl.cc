@@ -15,10 +15,55 @@
  */
 
 #include "graph/operator_factory_impl.h"
+#include <algorithm>
 #include "debug/ge_log.h"
 #include "framework/common/debug/ge_log.h"
+#include "utils/frozen_registry.h"
 
 namespace ge {
+namespace {
+FrozenRegistry<OpRegistryRecordMap> &GetFrozenRegistry() {
+  static FrozenRegistry<OpRegistryRecordMap> frozen_registry;
+  return frozen_registry;
+}
+
+// guarded by the registry lock
+std::set<std::string> *register_recorder = nullptr;
+
+// the duplicate check runs under the registry lock together with the insert, a duplicate keeps the frozen table
+template <typename FuncT>
+graphStatus RegisterFunc(shared_ptr<std::map<string, FuncT>> &funcs, const std::string &operator_type,
+                         const FuncT &func) {
+  bool registered = false;
+  GetFrozenRegistry().Update([&]() {
+    if (register_recorder != nullptr) {
+      (void)register_recorder->insert(operator_type);
+    }
+    if (funcs == nullptr) {
+      funcs.reset(new (std::nothrow) std::map<string, FuncT>());
+      if (funcs == nullptr) {
+        GELOGE(GRAPH_FAILED, "Failed to create registry map for %s.", operator_type.c_str());
+        return false;
+      }
+    }
+    registered = funcs->emplace(operator_type, func).second;
+    return registered;
+  });
+  return registered ? GRAPH_SUCCESS : GRAPH_FAILED;
+}
+
+template <typename FuncT>
+void FillRecords(const shared_ptr<std::map<string, FuncT>> &funcs, OpRegistryRecordMap &records,
+                 FuncT OpRegistryRecord::*field) {
+  if (funcs == nullptr) {
+    return;
+  }
+  for (const auto &it : *funcs) {
+    records[it.first].*field = it.second;
+  }
+}
+}  // namespace
+
 shared_ptr<std::map<string, OpCreator>> OperatorFactoryImpl::operator_creators_;
 shared_ptr<std::map<string, OpCreatorV2>> OperatorFactoryImpl::operator_creators_v2_;
 shared_ptr<std::map<string, InferShapeFunc>> OperatorFactoryImpl::operator_infershape_funcs_;
@@ -26,7 +71,60 @@ shared_ptr<std::map<string, InferFormatFunc>> OperatorFactoryImpl::operator_infe
 shared_ptr<std::map<string, VerifyFunc>> OperatorFactoryImpl::operator_verify_funcs_;
 shared_ptr<std::map<string, InferDataSliceFunc>> OperatorFactoryImpl::operator_infer_data_slice_funcs_;
 
+void OperatorFactoryImpl::Freeze() {
+  auto build = [](const OpRegistryRecordMap *, OpRegistryRecordMap &records) {
+    size_t max_size = 0;
+    max_size = std::max(max_size, (operator_creators_ == nullptr) ? 0 : operator_creators_->size());
+    max_size = std::max(max_size, (operator_creators_v2_ == nullptr) ? 0 : operator_creators_v2_->size());
+    records.reserve(max_size);
+    FillRecords(operator_creators_, records, &OpRegistryRecord::creator);
+    FillRecords(operator_creators_v2_, records, &OpRegistryRecord::creator_v2);
+    FillRecords(operator_infershape_funcs_, records, &OpRegistryRecord::infer_shape_func);
+    FillRecords(operator_inferformat_funcs_, records, &OpRegistryRecord::infer_format_func);
+    FillRecords(operator_verify_funcs_, records, &OpRegistryRecord::verify_func);
+    FillRecords(operator_infer_data_slice_funcs_, records, &OpRegistryRecord::infer_data_slice_func);
+    GELOGI("Freeze operator registry, %zu op types.", records.size());
+    return true;
+  };
+  if (GetFrozenRegistry().Freeze(build) == nullptr) {
+    GELOGE(GRAPH_FAILED, "Failed to create frozen operator registry.");
+  }
+}
+
+void OperatorFactoryImpl::SetRegisterRecorder(std::set<std::string> *op_types) {
+  std::lock_guard<std::mutex> lock(GetFrozenRegistry().GetMutex());
+  register_recorder = op_types;
+}
+
+bool OperatorFactoryImpl::IsFrozen() {
+  return GetFrozenRegistry().Get() != nullptr;
+}
+
+std::shared_ptr<const OpRegistryRecord> OperatorFactoryImpl::GetFrozenRecord(const std::string &operator_type,
+                                                                            bool &frozen) {
+  auto records = GetFrozenRegistry().Get();
+  frozen = (records != nullptr);
+  if (records == nullptr) {
+    return nullptr;
+  }
+  auto it = records->find(operator_type);
+  // the record keeps the table alive while the caller uses it
+  return (it == records->end()) ? nullptr : std::shared_ptr<const OpRegistryRecord>(records, &it->second);
+}
+
 Operator OperatorFactoryImpl::CreateOperator(const std::string &operator_name, const std::string &operator_type) {
+  bool frozen = false;
+  auto record = GetFrozenRecord(operator_type, frozen);
+  if (frozen) {
+    if ((record != nullptr) && (record->creator_v2 != nullptr)) {
+      return record->creator_v2(operator_name.c_str());
+    }
+    if ((record != nullptr) && (record->creator != nullptr)) {
+      return record->creator(operator_name);
+    }
+    GELOGW("no OpProto of [%s] registered.", operator_type.c_str());
+    return Operator();
+  }
   if (operator_creators_v2_ != nullptr) {
     auto it_v2 = operator_creators_v2_->find(operator_type);
     if (it_v2 != operator_creators_v2_->end()) {
@@ -69,6 +167,11 @@ graphStatus OperatorFactoryImpl::GetOpsTypeList(std::vector<std::string> &all_op
 }
 
 bool OperatorFactoryImpl::IsExistOp(const string &operator_type) {
+  bool frozen = false;
+  auto record = GetFrozenRecord(operator_type, frozen);
+  if (frozen) {
+    return (record != nullptr) && ((record->creator_v2 != nullptr) || (record->creator != nullptr));
+  }
   if (operator_creators_v2_ != nullptr) {
     auto it_v2 = operator_creators_v2_->find(operator_type);
     if (it_v2 != operator_creators_v2_->end()) {
@@ -87,6 +190,11 @@ bool OperatorFactoryImpl::IsExistOp(const string &operator_type) {
 }
 
 InferShapeFunc OperatorFactoryImpl::GetInferShapeFunc(const std::string &operator_type) {
+  bool frozen = false;
+  auto record = GetFrozenRecord(operator_type, frozen);
+  if (frozen) {
+    return (record == nullptr) ? nullptr : record->infer_shape_func;
+  }
   if (operator_infershape_funcs_ == nullptr) {
     return nullptr;
   }
@@ -98,6 +206,11 @@ InferShapeFunc OperatorFactoryImpl::GetInferShapeFunc(const std::string &operato
 }
 
 InferFormatFunc OperatorFactoryImpl::GetInferFormatFunc(const std::string &operator_type) {
+  bool frozen = false;
+  auto record = GetFrozenRecord(operator_type, frozen);
+  if (frozen) {
+    return (record == nullptr) ? nullptr : record->infer_format_func;
+  }
   if (operator_inferformat_funcs_ == nullptr) {
     GELOGI("operator_inferformat_funcs_ is null");
     return nullptr;
@@ -110,6 +223,11 @@ InferFormatFunc OperatorFactoryImpl::GetInferFormatFunc(const std::string &opera
 }
 
 VerifyFunc OperatorFactoryImpl::GetVerifyFunc(const std::string &operator_type) {
+  bool frozen = false;
+  auto record = GetFrozenRecord(operator_type, frozen);
+  if (frozen) {
+    return (record == nullptr) ? nullptr : record->verify_func;
+  }
   if (operator_verify_funcs_ == nullptr) {
     return nullptr;
   }
@@ -121,6 +239,11 @@ VerifyFunc OperatorFactoryImpl::GetVerifyFunc(const std::string &operator_type)
 }
 
 InferDataSliceFunc OperatorFactoryImpl::GetInferDataSliceFunc(const std::string &operator_type) {
+  bool frozen = false;
+  auto record = GetFrozenRecord(operator_type, frozen);
+  if (frozen) {
+    return (record == nullptr) ? nullptr : record->infer_data_slice_func;
+  }
   if (operator_infer_data_slice_funcs_ == nullptr) {
     return nullptr;
   }
@@ -132,81 +255,29 @@ InferDataSliceFunc OperatorFactoryImpl::GetInferDataSliceFunc(const std::string
 }
 
 graphStatus OperatorFactoryImpl::RegisterOperatorCreator(const string &operator_type, OpCreator const &op_creator) {
-  if (operator_creators_ == nullptr) {
-    operator_creators_.reset(new (std::nothrow) std::map<string, OpCreator>());
-  }
-  auto it = operator_creators_->find(operator_type);
-  if (it != operator_creators_->end()) {
-    return GRAPH_FAILED;
-  }
-  (void)operator_creators_->emplace(operator_type, op_creator);
-  return GRAPH_SUCCESS;
+  return RegisterFunc(operator_creators_, operator_type, op_creator);
 }
 
 graphStatus OperatorFactoryImpl::RegisterOperatorCreator(const string &operator_type, OpCreatorV2 const &op_creator) {
-  if (operator_creators_v2_ == nullptr) {
-    operator_creators_v2_.reset(new (std::nothrow) std::map<string, OpCreatorV2>());
-  }
-  auto it = operator_creators_v2_->find(operator_type);
-  if (it != operator_creators_v2_->end()) {
-    return GRAPH_FAILED;
-  }
-  (void)operator_creators_v2_->emplace(operator_type, op_creator);
-  return GRAPH_SUCCESS;
+  return RegisterFunc(operator_creators_v2_, operator_type, op_creator);
 }
 
 graphStatus OperatorFactoryImpl::RegisterInferShapeFunc(const std::string &operator_type,
                                                         InferShapeFunc const infer_shape_func) {
-  if (operator_infershape_funcs_ == nullptr) {
-    GELOGI("operator_infershape_funcs_ init");
-    operator_infershape_funcs_.reset(new (std::nothrow) std::map<string, InferShapeFunc>());
-  }
-  auto it = operator_infershape_funcs_->find(operator_type);
-  if (it != operator_infershape_funcs_->end()) {
-    return GRAPH_FAILED;
-  }
-  (void)operator_infershape_funcs_->emplace(operator_type, infer_shape_func);
-  return GRAPH_SUCCESS;
+  return RegisterFunc(operator_infershape_funcs_, operator_type, infer_shape_func);
 }
 
 graphStatus OperatorFactoryImpl::RegisterInferFormatFunc(const std::string &operator_type,
                                                          InferFormatFunc const infer_format_func) {
-  if (operator_inferformat_funcs_ == nullptr) {
-    GELOGI("operator_inferformat_funcs_ init");
-    operator_inferformat_funcs_.reset(new (std::nothrow) std::map<string, InferFormatFunc>());
-  }
-  auto it = operator_inferformat_funcs_->find(operator_type);
-  if (it != operator_inferformat_funcs_->end()) {
-    return GRAPH_FAILED;
-  }
-  (void)operator_inferformat_funcs_->emplace(operator_type, infer_format_func);
-  return GRAPH_SUCCESS;
+  return RegisterFunc(operator_inferformat_funcs_, operator_type, infer_format_func);
 }
 
 graphStatus OperatorFactoryImpl::RegisterVerifyFunc(const std::string &operator_type, VerifyFunc const verify_func) {
-  if (operator_verify_funcs_ == nullptr) {
-    GELOGI("operator_verify_funcs_ init");
-    operator_verify_funcs_.reset(new (std::nothrow) std::map<string, VerifyFunc>());
-  }
-  auto it = operator_verify_funcs_->find(operator_type);
-  if (it != operator_verify_funcs_->end()) {
-    return GRAPH_FAILED;
-  }
-  (void)operator_verify_funcs_->emplace(operator_type, verify_func);
-  return GRAPH_SUCCESS;
+  return RegisterFunc(operator_verify_funcs_, operator_type, verify_func);
 }
 
 graphStatus OperatorFactoryImpl::RegisterInferDataSliceFunc(const std::string &operator_type,
                                                             InferDataSliceFunc const infer_data_slice_func) {
-  if (operator_infer_data_slice_funcs_ == nullptr) {
-    GELOGI("operator_infer_data_slice_funcs_ init");
-    operator_infer_data_slice_funcs_.reset(new (std::nothrow) std::map<string, InferDataSliceFunc>());
-  }
-  auto it = operator_infer_data_slice_funcs_->find(operator_type);
-  if (it != operator_infer_data_slice_funcs_->end()) {
-    return GRAPH_FAILED;
-  }
-  (void)operator_infer_data_slice_funcs_->emplace(operator_type, infer_data_slice_func);
-  return GRAPH_SUCCESS;
+  return RegisterFunc(operator_infer_data_slice_funcs_, operator_type, infer_data_slice_func);
 }
 }  // namespace ge
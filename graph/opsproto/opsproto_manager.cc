@@ -15,17 +15,33 @@
  */
 
 #include "graph/opsproto_manager.h"
+#include <cstdio>
 #include <cstdlib>
 #include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <functional>
 #include <iostream>
+#include <set>
 #include <sstream>
 #include "debug/ge_util.h"
 #include "framework/common/debug/ge_log.h"
 #include "graph/debug/ge_log.h"
+#include "graph/operator_factory_impl.h"
 #include "mmpa/mmpa_api.h"
 
 namespace ge {
+namespace {
+const char *const kOptionOpsProtoLibPath = "ge.opsProtoLibPath";
+const char *const kOptionOpsProtoManifestPath = "ge.opsProtoManifestPath";
+const char *const kOptionOpsProtoLazyLoad = "ge.opsProtoLazyLoad";
+const char *const kManifestHeader = "ops_proto_manifest_v1";
+const char kManifestDelim = '\t';
+const char kOpTypeDelim = ',';
+}  // namespace
+
+static std::vector<std::string> Split(const std::string &str, char delim);
+
 OpsProtoManager *OpsProtoManager::Instance() {
   static OpsProtoManager instance;
   return &instance;
@@ -40,7 +56,7 @@ bool OpsProtoManager::Initialize(const std::map<std::string, std::string> &optio
   }
 
   /*lint -e1561*/
-  auto proto_iter = options.find("ge.opsProtoLibPath");
+  auto proto_iter = options.find(kOptionOpsProtoLibPath);
   /*lint +e1561*/
   if (proto_iter == options.end()) {
     GELOGW("ge.opsProtoLibPath option not set, return.");
@@ -48,6 +64,10 @@ bool OpsProtoManager::Initialize(const std::map<std::string, std::string> &optio
   }
 
   pluginPath_ = proto_iter->second;
+  auto manifest_iter = options.find(kOptionOpsProtoManifestPath);
+  manifest_path_ = (manifest_iter == options.end()) ? "" : manifest_iter->second;
+  auto lazy_iter = options.find(kOptionOpsProtoLazyLoad);
+  lazy_load_ = (lazy_iter != options.end()) && (lazy_iter->second == "1");
   LoadOpsProtoPluginSo(pluginPath_);
 
   is_init_ = true;
@@ -63,9 +83,12 @@ void OpsProtoManager::Finalize() {
     return;
   }
 
-  for (auto handle : handles_) {
-    if (handle != nullptr) {
-      if (mmDlclose(handle) != 0) {
+  for (auto &lib : libs_) {
+    if (!lib.loaded) {
+      continue;
+    }
+    if (lib.handle != nullptr) {
+      if (mmDlclose(lib.handle) != 0) {
         const char *error = mmDlerror();
         error = (error == nullptr) ? "" : error;
         GELOGW("failed to close handle, message: %s", error);
@@ -76,10 +99,69 @@ void OpsProtoManager::Finalize() {
       GELOGW("close opsprotomanager handler failure, handler is nullptr");
     }
   }
+  libs_.clear();
+  op_lib_index_.clear();
 
   is_init_ = false;
 }
 
+bool OpsProtoManager::LoadOpsProto(const std::vector<std::string> &op_types) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!is_init_) {
+    GELOGW("OpsProtoManager is not initialized.");
+    return false;
+  }
+  bool loaded = false;
+  for (const auto &op_type : op_types) {
+    auto iter = op_lib_index_.find(op_type);
+    if (iter == op_lib_index_.end()) {
+      continue;
+    }
+    auto &lib = libs_[iter->second];
+    if (!lib.loaded) {
+      GELOGI("OpsProtoManager load %s for op type %s.", lib.path.c_str(), op_type.c_str());
+      LoadLib(lib, false);
+      loaded = true;
+    }
+  }
+  if (loaded) {
+    OperatorFactoryImpl::Freeze();
+  }
+  return true;
+}
+
+bool OpsProtoManager::LoadAllOpsProto() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!is_init_) {
+    GELOGW("OpsProtoManager is not initialized.");
+    return false;
+  }
+  bool loaded = false;
+  for (auto &lib : libs_) {
+    if (!lib.loaded) {
+      LoadLib(lib, false);
+      loaded = true;
+    }
+  }
+  if (loaded) {
+    OperatorFactoryImpl::Freeze();
+  }
+  return true;
+}
+
+void OpsProtoManager::GetLoadStats(std::vector<OpsProtoLibStat> &stats) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats.clear();
+  for (const auto &lib : libs_) {
+    OpsProtoLibStat stat;
+    stat.path = lib.path;
+    stat.loaded = lib.loaded;
+    stat.load_time_us = lib.load_time_us;
+    stat.op_num = lib.op_types.size();
+    stats.emplace_back(stat);
+  }
+}
+
 static std::vector<std::string> Split(const std::string &str, char delim) {
   std::vector<std::string> elems;
   if (str.empty()) {
@@ -180,19 +262,152 @@ void OpsProtoManager::LoadOpsProtoPluginSo(std::string &path) {
   // Warning message
   GELOGW("The shared library will not be checked. Please ensure that the source of the shared library is trusted.");
 
-  // Load .so file
-  for (auto elem : file_list) {
-    void *handle = mmDlopen(elem.c_str(), MMPA_RTLD_NOW | MMPA_RTLD_GLOBAL);
-    if (handle == nullptr) {
-      const char *error = mmDlerror();
-      error = (error == nullptr) ? "" : error;
-      GELOGW("OpsProtoManager dlopen failed, plugin name:%s. Message(%s).", elem.c_str(), error);
-      continue;
-    } else {
-      // Close dl when the program exist, not close here
-      GELOGI("OpsProtoManager plugin load %s success.", elem.c_str());
-      handles_.push_back(handle);
+  libs_.clear();
+  op_lib_index_.clear();
+  for (const auto &elem : file_list) {
+    OpsProtoLib lib;
+    lib.path = elem;
+    mmStat_t stat_buf;
+    if (mmStatGet(elem.c_str(), &stat_buf) == EN_OK) {
+      lib.size = static_cast<int64_t>(stat_buf.st_size);
+      lib.mtime = static_cast<int64_t>(stat_buf.st_mtime);
+    }
+    libs_.emplace_back(lib);
+  }
+
+  bool manifest_valid = (!manifest_path_.empty()) && LoadManifest();
+  if (lazy_load_ && manifest_valid) {
+    for (size_t i = 0; i < libs_.size(); ++i) {
+      for (const auto &op_type : libs_[i].op_types) {
+        (void)op_lib_index_.emplace(op_type, i);
+      }
+    }
+    GELOGI("OpsProtoManager lazy load is enabled, %zu libs with %zu op types in manifest.", libs_.size(),
+           op_lib_index_.size());
+    return;
+  }
+
+  // Record the op types provided by each lib only when the manifest need to be rebuilt
+  bool record_ops = (!manifest_path_.empty()) && (!manifest_valid);
+  uint64_t total_time_us = 0;
+  for (auto &lib : libs_) {
+    LoadLib(lib, record_ops);
+    total_time_us += lib.load_time_us;
+  }
+  GELOGI("OpsProtoManager load %zu libs cost %lu us.", libs_.size(), total_time_us);
+  if (record_ops) {
+    SaveManifest();
+  }
+  OperatorFactoryImpl::Freeze();
+}
+
+void OpsProtoManager::LoadLib(OpsProtoLib &lib, bool record_ops) {
+  // registrars of the lib run inside dlopen, every op type they register is recorded, also infer functions only
+  // and types registered before by other libs, so the lib is loaded again for any of them in lazy mode
+  std::set<std::string> lib_ops;
+  if (record_ops) {
+    OperatorFactoryImpl::SetRegisterRecorder(&lib_ops);
+  }
+  auto start = std::chrono::steady_clock::now();
+  void *handle = mmDlopen(lib.path.c_str(), MMPA_RTLD_NOW | MMPA_RTLD_GLOBAL);
+  auto end = std::chrono::steady_clock::now();
+  if (record_ops) {
+    OperatorFactoryImpl::SetRegisterRecorder(nullptr);
+  }
+  lib.load_time_us =
+      static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+  // Mark as loaded even if dlopen failed, so that it will not be retried again and again
+  lib.loaded = true;
+  if (handle == nullptr) {
+    const char *error = mmDlerror();
+    error = (error == nullptr) ? "" : error;
+    GELOGW("OpsProtoManager dlopen failed, plugin name:%s. Message(%s).", lib.path.c_str(), error);
+    return;
+  }
+  // Close dl when the program exist, not close here
+  lib.handle = handle;
+  if (record_ops) {
+    lib.op_types.assign(lib_ops.begin(), lib_ops.end());
+  }
+  GELOGI("OpsProtoManager plugin load %s success, cost %lu us.", lib.path.c_str(), lib.load_time_us);
+}
+
+bool OpsProtoManager::LoadManifest() {
+  std::ifstream fs(manifest_path_, std::ifstream::in);
+  if (!fs.is_open()) {
+    GELOGI("OpsProtoManager manifest %s not exist.", manifest_path_.c_str());
+    return false;
+  }
+  std::string line;
+  if (!std::getline(fs, line) || (line != kManifestHeader)) {
+    GELOGW("OpsProtoManager manifest %s is invalid.", manifest_path_.c_str());
+    return false;
+  }
+
+  std::map<std::string, size_t> lib_index;
+  for (size_t i = 0; i < libs_.size(); ++i) {
+    lib_index[libs_[i].path] = i;
+  }
+  std::vector<std::vector<std::string>> op_types(libs_.size());
+  size_t matched_num = 0;
+  // each line: path \t size \t mtime \t op_type,op_type,...
+  while (std::getline(fs, line)) {
+    auto fields = Split(line, kManifestDelim);
+    if (fields.size() != 4) {  // 4: path, size, mtime and op types
+      GELOGW("OpsProtoManager manifest %s is invalid.", manifest_path_.c_str());
+      return false;
+    }
+    auto iter = lib_index.find(fields[0]);
+    if ((iter == lib_index.end()) || (std::to_string(libs_[iter->second].size) != fields[1]) ||
+        (std::to_string(libs_[iter->second].mtime) != fields[2])) {
+      GELOGI("OpsProtoManager manifest %s is out of date, lib %s.", manifest_path_.c_str(), fields[0].c_str());
+      return false;
+    }
+    if (!fields[3].empty()) {
+      op_types[iter->second] = Split(fields[3], kOpTypeDelim);
+    }
+    ++matched_num;
+  }
+  if (matched_num != libs_.size()) {
+    GELOGI("OpsProtoManager manifest %s is out of date.", manifest_path_.c_str());
+    return false;
+  }
+  for (size_t i = 0; i < libs_.size(); ++i) {
+    libs_[i].op_types = std::move(op_types[i]);
+  }
+  return true;
+}
+
+void OpsProtoManager::SaveManifest() const {
+  // write a temp file and rename it, so other processes never read a partially written manifest
+  std::string tmp_path = manifest_path_ + ".tmp." + std::to_string(mmGetPid());
+  std::ofstream fs(tmp_path, std::ofstream::out | std::ofstream::trunc);
+  if (!fs.is_open()) {
+    GELOGW("OpsProtoManager can not write manifest %s.", tmp_path.c_str());
+    return;
+  }
+  fs << kManifestHeader << "\n";
+  for (const auto &lib : libs_) {
+    fs << lib.path << kManifestDelim << lib.size << kManifestDelim << lib.mtime << kManifestDelim;
+    for (size_t i = 0; i < lib.op_types.size(); ++i) {
+      if (i != 0) {
+        fs << kOpTypeDelim;
+      }
+      fs << lib.op_types[i];
     }
+    fs << "\n";
+  }
+  fs.close();
+  if (fs.fail()) {
+    GELOGW("OpsProtoManager failed to write manifest %s.", tmp_path.c_str());
+    (void)mmUnlink(tmp_path.c_str());
+    return;
+  }
+  if (std::rename(tmp_path.c_str(), manifest_path_.c_str()) != 0) {
+    GELOGW("OpsProtoManager failed to rename %s to %s.", tmp_path.c_str(), manifest_path_.c_str());
+    (void)mmUnlink(tmp_path.c_str());
+    return;
   }
+  GELOGI("OpsProtoManager save manifest %s, %zu libs.", manifest_path_.c_str(), libs_.size());
 }
 }  // namespace ge
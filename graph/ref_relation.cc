@@ -16,6 +16,8 @@
 
 #include "graph/ref_relation.h"
 
+#include <atomic>
+#include <mutex>
 #include <unordered_set>
 #include <unordered_map>
 
@@ -50,9 +52,37 @@ namespace {
 class RefRelations::Impl {
 public:
   graphStatus LookUpRefRelations(const RefCell &key, unordered_set<RefCell, RefCellHash> &result) {
-    unsigned long number = static_cast<unsigned long>(reinterpret_cast<uintptr_t>(key.node.get()));
-    std::string lookup_key = key.node_name + std::to_string(key.in_out) + std::to_string(key.in_out_idx)
-                           + std::to_string(number);
+    // an eagerly built table is only read here, like before, it must not be looked up while being built or cleared
+    if (!is_lazy_.load()) {
+      return LookUpTable(GetLookUpKey(key), result);
+    }
+    // lookups of lazy mode fill the table, so they are serialized with each other and with builds
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string lookup_key = GetLookUpKey(key);
+    if (is_lazy_.load() && (look_up_table_.count(lookup_key) == 0)) {
+      auto status = BuildRefRelationsOfCell(key);
+      if (status != GRAPH_SUCCESS) {
+        return status;
+      }
+    }
+    return LookUpTable(lookup_key, result);
+  };
+  graphStatus BuildRefRelations(ge::ComputeGraph &root_graph);
+  graphStatus BuildRefRelationsLazily(const ge::ComputeGraph &graph) {
+    GELOGD("Ref relations of graph %s will be built on lookup!", graph.GetName().c_str());
+    std::lock_guard<std::mutex> lock(mutex_);
+    ClearTable();
+    is_lazy_ = true;
+    return GRAPH_SUCCESS;
+  };
+  graphStatus Clear() {
+    GELOGD("Start clear boundary reflections between main graph and sub graph!");
+    std::lock_guard<std::mutex> lock(mutex_);
+    ClearTable();
+    return GRAPH_SUCCESS;
+  };
+private:
+  graphStatus LookUpTable(const std::string &lookup_key, unordered_set<RefCell, RefCellHash> &result) const {
     auto iter = look_up_table_.find(lookup_key);
     if (iter != look_up_table_.end()) {
       for (auto &c : iter->second) {
@@ -62,16 +92,16 @@ public:
     }
     GELOGW("can not find any relations! key value of dest relation is %s", lookup_key.c_str());
     return GRAPH_SUCCESS;
-  };
-  graphStatus BuildRefRelations(ge::ComputeGraph &root_graph);
-  graphStatus Clear() {
-    GELOGD("Start clear boundary reflections between main graph and sub graph!");
+  }
+  void ClearTable() {
     look_up_table_.clear();
-    values_.clear();
-    return GRAPH_SUCCESS;
-  };
-private:
-  graphStatus BuildLookUpTables();
+    built_func_nodes_.clear();
+  }
+  static std::string GetLookUpKey(const RefCell &ref_cell);
+  void AddToLookUpTable(const vector<vector<RefCell>> &node_refs);
+  graphStatus BuildRefRelationsOfFuncNode(const ge::ComputeGraph &root_graph, const NodePtr &node,
+                                          vector<vector<RefCell>> &node_refs);
+  graphStatus BuildRefRelationsOfCell(const RefCell &key);
   graphStatus BuildRefRelationsForBranch(
                   const NodePtr &root_node,
                   const vector<vector<NodePtr>> &classed_data_nodes,
@@ -103,7 +133,10 @@ private:
                   vector<vector<std::pair<NodePtr, size_t>>> &classed_netoutput_nodes);
 
   std::unordered_map<string, vector<RefCell>> look_up_table_;
-  std::vector<vector<vector<RefCell>>> values_;
+  // lazy mode builds relations of a function node on the first lookup of a cell around it, written under mutex_
+  std::atomic<bool> is_lazy_{false};
+  std::unordered_set<const Node *> built_func_nodes_;
+  std::mutex mutex_;
 };
 
 // Node Level
@@ -164,20 +197,17 @@ graphStatus RefRelations::Impl::BuildRefRelationsForBranch(
   return GRAPH_SUCCESS;
 }
 
-graphStatus RefRelations::Impl::BuildLookUpTables() {
-  GELOGD("start to build look up table!");
-  for (size_t i = 0; i < values_.size(); i++) {
-    vector<vector<RefCell>> &val = values_[i];
-    for (const auto &ele : val) {
-      for (const auto &ref_cell : ele) {
-        string key = ref_cell.node_name + std::to_string(ref_cell.in_out) +
-          std::to_string(ref_cell.in_out_idx) +
-          std::to_string(static_cast<unsigned long>(reinterpret_cast<uintptr_t>(ref_cell.node.get())));
-        look_up_table_[key] = ele;
-      }
+std::string RefRelations::Impl::GetLookUpKey(const RefCell &ref_cell) {
+  return ref_cell.node_name + std::to_string(ref_cell.in_out) + std::to_string(ref_cell.in_out_idx) +
+         std::to_string(static_cast<unsigned long>(reinterpret_cast<uintptr_t>(ref_cell.node.get())));
+}
+
+void RefRelations::Impl::AddToLookUpTable(const vector<vector<RefCell>> &node_refs) {
+  for (const auto &ele : node_refs) {
+    for (const auto &ref_cell : ele) {
+      look_up_table_[GetLookUpKey(ref_cell)] = ele;
     }
   }
-  return GRAPH_SUCCESS;
 }
 
 graphStatus RefRelations::Impl::BuildRefRelationsForWhile(
@@ -257,7 +287,7 @@ graphStatus RefRelations::Impl::BuildRefRelationsForWhile(
       GELOGW("Node[%s]\'s peer_out_data_node or peer_out_data_node desc is null", (netoutput->GetName()).c_str());
       continue;
     }
-    if (peer_out_data_node->GetType() != DATA) {
+    if (peer_out_data_node->GetTypeRef() != DATA) {
       continue;
     }
     auto in_data_anchor_idx = in_anchor->GetIdx();
@@ -401,6 +431,7 @@ graphStatus RefRelations::Impl::ProcessSubgraphNetoutput(
 
 graphStatus RefRelations::Impl::BuildRefRelations(ge::ComputeGraph &graph) {
   GELOGD("Start to build ref relations!");
+  std::lock_guard<std::mutex> lock(mutex_);
   /* First Step: Get root graph */
   ge::ComputeGraph &root_graph = graph;
   auto status = GetRootGraph(graph, root_graph);
@@ -408,53 +439,90 @@ graphStatus RefRelations::Impl::BuildRefRelations(ge::ComputeGraph &graph) {
     return status;
   }
 
+  is_lazy_ = false;
   for (const auto &node : graph.GetAllNodes()) {
-    auto node_type = node->GetType();
-    std::vector<NodePtr> ref_nodes;
-    auto op_desc = node->GetOpDesc();
-    auto sub_graph_names = op_desc->GetSubgraphInstanceNames();
-    if (sub_graph_names.empty()) {
+    if (node->GetOpDesc()->GetSubgraphInstanceNames().empty()) {
       continue;
     }
-    vector<NodePtr> data_nodes;
-    vector<NodePtr> netoutput_nodes;
-    // Get data and netoutput of sub_graph
-    GetDataAndNetoutputOfSubGraph(root_graph, data_nodes, netoutput_nodes, sub_graph_names, node_type);
-    size_t max_elem_num = (data_nodes.size() > kMaxElementNum) ? data_nodes.size() : kMaxElementNum;
-    vector<vector<NodePtr>> classed_data_nodes(max_elem_num);   // according to ref_idx
-    vector<vector<std::pair<NodePtr, size_t>>> classed_netoutput_nodes(max_elem_num);   // according to ref_idx
-    status = ProcessSubgraphDataNodes(data_nodes, classed_data_nodes);
+    vector<vector<RefCell>> node_refs;
+    status = BuildRefRelationsOfFuncNode(root_graph, node, node_refs);
     if (status != GRAPH_SUCCESS) {
-      GELOGE(GRAPH_FAILED, "classfy data nodes failed!");
       return status;
     }
+    /* Seconde Step: generate map */
+    AddToLookUpTable(node_refs);
+  }
+  return GRAPH_SUCCESS;
+}
 
-    // for netoutput
-    // check netoutput
-    // here main graph output number must be the same as every sub_graph netoutput node
-    // key: netoutput node_ptr ,<ref_idx, net_in_idx>
-    status = ProcessSubgraphNetoutput(netoutput_nodes, classed_netoutput_nodes);
-    if (status != GRAPH_SUCCESS) {
-      GELOGE(GRAPH_FAILED, "process netoutput failed!");
-      return status;
-    }
+graphStatus RefRelations::Impl::BuildRefRelationsOfFuncNode(const ge::ComputeGraph &root_graph, const NodePtr &node,
+                                                            vector<vector<RefCell>> &node_refs) {
+  auto node_type = node->GetType();
+  const auto &sub_graph_names = node->GetOpDesc()->GetSubgraphInstanceNames();
+  vector<NodePtr> data_nodes;
+  vector<NodePtr> netoutput_nodes;
+  // Get data and netoutput of sub_graph
+  GetDataAndNetoutputOfSubGraph(root_graph, data_nodes, netoutput_nodes, sub_graph_names, node_type);
+  size_t max_elem_num = (data_nodes.size() > kMaxElementNum) ? data_nodes.size() : kMaxElementNum;
+  vector<vector<NodePtr>> classed_data_nodes(max_elem_num);   // according to ref_idx
+  vector<vector<std::pair<NodePtr, size_t>>> classed_netoutput_nodes(max_elem_num);   // according to ref_idx
+  auto status = ProcessSubgraphDataNodes(data_nodes, classed_data_nodes);
+  if (status != GRAPH_SUCCESS) {
+    GELOGE(GRAPH_FAILED, "classfy data nodes failed!");
+    return status;
+  }
 
-    vector<vector<RefCell>> node_refs;
-    status = BuildRelationsWithFuncNodeType(node, classed_data_nodes, classed_netoutput_nodes, node_refs);
-    if (status != GRAPH_SUCCESS) {
-      GELOGE(status, "BuildRelationsWithFuncNodeType Failed! Node is [%s]!", node->GetName().c_str());
-      return status;
+  // for netoutput
+  // check netoutput
+  // here main graph output number must be the same as every sub_graph netoutput node
+  // key: netoutput node_ptr ,<ref_idx, net_in_idx>
+  status = ProcessSubgraphNetoutput(netoutput_nodes, classed_netoutput_nodes);
+  if (status != GRAPH_SUCCESS) {
+    GELOGE(GRAPH_FAILED, "process netoutput failed!");
+    return status;
+  }
+
+  status = BuildRelationsWithFuncNodeType(node, classed_data_nodes, classed_netoutput_nodes, node_refs);
+  if (status != GRAPH_SUCCESS) {
+    GELOGE(status, "BuildRelationsWithFuncNodeType Failed! Node is [%s]!", node->GetName().c_str());
+    return status;
+  }
+  return GRAPH_SUCCESS;
+}
+
+graphStatus RefRelations::Impl::BuildRefRelationsOfCell(const RefCell &key) {
+  const NodePtr &node = key.node;
+  if ((node == nullptr) || (node->GetOpDesc() == nullptr)) {
+    return GRAPH_SUCCESS;
+  }
+  // cells only live on function nodes and on data(with parent index)/netoutput nodes of their subgraphs
+  NodePtr func_node = node;
+  if (node->GetOpDesc()->GetSubgraphInstanceNames().empty()) {
+    if ((node->GetTypeRef() != DATA) && (node->GetTypeRef() != NETOUTPUT)) {
+      return GRAPH_SUCCESS;
     }
-    if (!node_refs.empty()) {
-      values_.push_back(node_refs);
+    if ((node->GetTypeRef() == DATA) && !node->GetOpDesc()->HasAttr(kRefIndex)) {
+      return GRAPH_SUCCESS;
     }
+    auto owner_graph = node->GetOwnerComputeGraph();
+    func_node = (owner_graph == nullptr) ? nullptr : owner_graph->GetParentNode();
+    if ((func_node == nullptr) || (func_node->GetOpDesc() == nullptr)) {
+      return GRAPH_SUCCESS;
+    }
+  }
+  if (built_func_nodes_.count(func_node.get()) > 0) {
+    return GRAPH_SUCCESS;
   }
-  /* Seconde Step: generate map */
-  status = BuildLookUpTables();
+
+  auto root_graph = GraphUtils::FindRootGraph(func_node->GetOwnerComputeGraph());
+  GE_CHECK_NOTNULL(root_graph);
+  vector<vector<RefCell>> node_refs;
+  auto status = BuildRefRelationsOfFuncNode(*root_graph, func_node, node_refs);
   if (status != GRAPH_SUCCESS) {
-    GELOGE(status, "Build look up tables failed!");
     return status;
   }
+  AddToLookUpTable(node_refs);
+  built_func_nodes_.insert(func_node.get());
   return GRAPH_SUCCESS;
 }
 
@@ -477,6 +545,11 @@ graphStatus RefRelations::BuildRefRelations(ge::ComputeGraph &root_graph) {
   return impl_->BuildRefRelations(root_graph);
 }
 
+graphStatus RefRelations::BuildRefRelationsLazily(ge::ComputeGraph &root_graph) {
+  GE_CHECK_NOTNULL(impl_);
+  return impl_->BuildRefRelationsLazily(root_graph);
+}
+
 graphStatus RefRelations::Clear() {
   GE_CHECK_NOTNULL(impl_);
   return impl_->Clear();
@@ -17,54 +17,190 @@
 #include "graph/runtime_inference_context.h"
 #include "graph/utils/tensor_adapter.h"
 #include <cstdint>
+#include <cstdlib>
 #include "framework/common/debug/ge_log.h"
 
 namespace ge {
-std::map<std::string, std::unique_ptr<RuntimeInferenceContext>> RuntimeInferenceContext::contexts_;
+namespace {
+struct ContextCache {
+  uint64_t version = 0;
+  uint64_t session_id = 0;
+  RuntimeInferenceContext *ctx = nullptr;
+};
+thread_local ContextCache context_cache;
+
+bool ParseContextId(const std::string &context_id, uint64_t &session_id) {
+  if (context_id.empty()) {
+    return false;
+  }
+  char *end = nullptr;
+  session_id = std::strtoull(context_id.c_str(), &end, 10);  // 10: decimal
+  return (end != nullptr) && (*end == '\0');
+}
+}  // namespace
+
+struct RuntimeInferenceContext::NodeTensorsChunk {
+  NodeTensors nodes[kChunkNodeNum];
+};
+
+const int64_t RuntimeInferenceContext::kChunkNodeNum;
+const int64_t RuntimeInferenceContext::kMaxChunkNum;
+std::map<uint64_t, std::unique_ptr<RuntimeInferenceContext>> RuntimeInferenceContext::contexts_;
+std::atomic<uint64_t> RuntimeInferenceContext::contexts_version_(1);
 std::mutex RuntimeInferenceContext::ctx_mu_;
 
+RuntimeInferenceContext::RuntimeInferenceContext() {
+  for (auto &chunk : chunks_) {
+    chunk.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+RuntimeInferenceContext::~RuntimeInferenceContext() {
+  for (auto &chunk : chunks_) {
+    delete chunk.load(std::memory_order_relaxed);
+  }
+}
+
 graphStatus RuntimeInferenceContext::CreateContext(const std::string &context_id) {
-  GELOGI("To create context. session id = %s", context_id.c_str());
+  uint64_t session_id = 0;
+  if (!ParseContextId(context_id, session_id)) {
+    GELOGE(GRAPH_PARAM_INVALID, "Invalid context id: %s", context_id.c_str());
+    return GRAPH_PARAM_INVALID;
+  }
+  return CreateContext(session_id);
+}
+
+void RuntimeInferenceContext::DestroyContext(const std::string &context_id) {
+  uint64_t session_id = 0;
+  if (!ParseContextId(context_id, session_id)) {
+    GELOGW("Invalid context id: %s", context_id.c_str());
+    return;
+  }
+  DestroyContext(session_id);
+}
+
+graphStatus RuntimeInferenceContext::GetContext(const std::string &context_id, RuntimeInferenceContext **ctx) {
+  uint64_t session_id = 0;
+  if (!ParseContextId(context_id, session_id)) {
+    GELOGD("Runtime inference context not created. session id = %s", context_id.c_str());
+    return GRAPH_FAILED;
+  }
+  return GetContext(session_id, ctx);
+}
+
+graphStatus RuntimeInferenceContext::CreateContext(uint64_t session_id) {
+  GELOGI("To create context. session id = %lu", session_id);
   auto ctx = std::unique_ptr<RuntimeInferenceContext>(new (std::nothrow)RuntimeInferenceContext());
   if (ctx == nullptr) {
     GELOGE(GRAPH_FAILED,
-           "Failed to create instance of RuntimeInferenceContext. context_id = %s",
-           context_id.c_str());
+           "Failed to create instance of RuntimeInferenceContext. context_id = %lu",
+           session_id);
     return GRAPH_FAILED;
   }
 
   std::lock_guard<std::mutex> lk(ctx_mu_);
-  auto emplace_ret = contexts_.emplace(context_id, std::move(ctx));
+  auto emplace_ret = contexts_.emplace(session_id, std::move(ctx));
   if (!emplace_ret.second) {
     GELOGE(GRAPH_FAILED, "Old context not destroyed");
     return GRAPH_FAILED;
   }
+  contexts_version_.fetch_add(1, std::memory_order_release);
 
   return GRAPH_SUCCESS;
 }
 
-void RuntimeInferenceContext::DestroyContext(const std::string &context_id) {
-  GELOGI("To destroy context. session id = %s", context_id.c_str());
+void RuntimeInferenceContext::DestroyContext(uint64_t session_id) {
+  GELOGI("To destroy context. session id = %lu", session_id);
   std::lock_guard<std::mutex> lk(ctx_mu_);
-  contexts_.erase(context_id);
+  // invalidate the cached lookups of all threads before the context is released
+  contexts_version_.fetch_add(1, std::memory_order_release);
+  contexts_.erase(session_id);
 }
 
-graphStatus RuntimeInferenceContext::GetContext(const std::string &context_id, RuntimeInferenceContext **ctx) {
+graphStatus RuntimeInferenceContext::GetContext(uint64_t session_id, RuntimeInferenceContext **ctx) {
+  // contexts are created and destroyed once per session, so the last lookup of this thread
+  // stays valid until the registry version changes
+  uint64_t version = contexts_version_.load(std::memory_order_acquire);
+  if ((context_cache.version == version) && (context_cache.session_id == session_id) &&
+      (context_cache.ctx != nullptr)) {
+    *ctx = context_cache.ctx;
+    return GRAPH_SUCCESS;
+  }
+
   std::lock_guard<std::mutex> lk(ctx_mu_);
-  auto it = contexts_.find(context_id);
+  version = contexts_version_.load(std::memory_order_relaxed);
+  auto it = contexts_.find(session_id);
   if (it != contexts_.end()) {
+    context_cache.version = version;
+    context_cache.session_id = session_id;
+    context_cache.ctx = it->second.get();
     *ctx = it->second.get();
     return GRAPH_SUCCESS;
   }
 
-  GELOGD("Runtime inference context not created. session id = %s", context_id.c_str());
+  GELOGD("Runtime inference context not created. session id = %lu", session_id);
   return GRAPH_FAILED;
 }
 
+RuntimeInferenceContext::NodeTensors *RuntimeInferenceContext::GetNodeTensors(int64_t node_id, bool create) {
+  if ((node_id >= 0) && (node_id < kChunkNodeNum * kMaxChunkNum)) {
+    auto &chunk_ref = chunks_[node_id / kChunkNodeNum];
+    NodeTensorsChunk *chunk = chunk_ref.load(std::memory_order_acquire);
+    if (chunk == nullptr) {
+      if (!create) {
+        return nullptr;
+      }
+      NodeTensorsChunk *new_chunk = new (std::nothrow) NodeTensorsChunk();
+      if (new_chunk == nullptr) {
+        GELOGE(GRAPH_FAILED, "Failed to create tensor chunk for node_id = %ld", node_id);
+        return nullptr;
+      }
+      if (chunk_ref.compare_exchange_strong(chunk, new_chunk, std::memory_order_acq_rel)) {
+        chunk = new_chunk;
+      } else {
+        // another thread published the chunk first, chunk has been updated to it
+        delete new_chunk;
+      }
+    }
+    return &chunk->nodes[node_id % kChunkNodeNum];
+  }
 
-graphStatus RuntimeInferenceContext::SetTensor(int64_t node_id, int output_id, Tensor &&tensor) {
   std::lock_guard<std::mutex> lk(mu_);
-  auto &output_tensors = tensors_[node_id];
+  auto iter = node_tensors_.find(node_id);
+  if (iter != node_tensors_.end()) {
+    return iter->second.get();
+  }
+  if (!create) {
+    return nullptr;
+  }
+  auto node_tensors = std::unique_ptr<NodeTensors>(new (std::nothrow) NodeTensors());
+  if (node_tensors == nullptr) {
+    GELOGE(GRAPH_FAILED, "Failed to create node tensors for node_id = %ld", node_id);
+    return nullptr;
+  }
+  auto ret = node_tensors.get();
+  node_tensors_[node_id] = std::move(node_tensors);
+  return ret;
+}
+
+graphStatus RuntimeInferenceContext::SetTensor(int64_t node_id, int output_id, Tensor &&tensor) {
+  if (output_id < 0) {
+    GELOGE(GRAPH_PARAM_INVALID, "Invalid output index: %d", output_id);
+    return GRAPH_PARAM_INVALID;
+  }
+  auto node_tensors = GetNodeTensors(node_id, true);
+  if (node_tensors == nullptr) {
+    return GRAPH_FAILED;
+  }
+
+  std::lock_guard<std::mutex> lk(node_tensors->mu);
+  // readers may still hold the published outputs, so a changed copy is published instead
+  auto outputs = std::make_shared<NodeOutputs>();
+  auto old_outputs = std::atomic_load(&node_tensors->outputs);
+  if (old_outputs != nullptr) {
+    *outputs = *old_outputs;
+  }
+  auto &output_tensors = outputs->tensors;
   if (static_cast<uint32_t>(output_id) >= output_tensors.size()) {
     output_tensors.resize(output_id + 1);
   }
@@ -72,13 +208,14 @@ graphStatus RuntimeInferenceContext::SetTensor(int64_t node_id, int output_id, T
   GELOGD("Set tensor for node_id = %ld, output_id = %d", node_id, output_id);
   output_tensors[output_id] = std::move(tensor);
 
-  auto &output_ge_tensors = ge_tensors_[node_id];
+  auto &output_ge_tensors = outputs->ge_tensors;
   if (static_cast<uint32_t>(output_id) >= output_ge_tensors.size()) {
     output_ge_tensors.resize(output_id + 1);
   }
 
   GELOGD("Set ge tensor for node_id = %ld, output_id = %d", node_id, output_id);
-  output_ge_tensors[output_id] = TensorAdapter::AsGeTensorPtr(tensor);
+  output_ge_tensors[output_id] = TensorAdapter::AsGeTensorPtr(output_tensors[output_id]);
+  std::atomic_store(&node_tensors->outputs, std::shared_ptr<const NodeOutputs>(outputs));
   return GRAPH_SUCCESS;
 }
 
@@ -88,14 +225,13 @@ graphStatus RuntimeInferenceContext::GetTensor(int64_t node_id, int output_id, T
     return GRAPH_PARAM_INVALID;
   }
 
-  std::lock_guard<std::mutex> lk(mu_);
-  auto iter = tensors_.find(node_id);
-  if (iter == tensors_.end()) {
+  auto node_tensors = GetNodeTensors(node_id, false);
+  auto outputs = (node_tensors == nullptr) ? nullptr : std::atomic_load(&node_tensors->outputs);
+  if ((outputs == nullptr) || outputs->tensors.empty()) {
     GELOGE(INTERNAL_ERROR, "Node not register. Id = %ld", node_id);
     return INTERNAL_ERROR;
   }
-
-  auto &output_tensors = iter->second;
+  auto &output_tensors = outputs->tensors;
   if (static_cast<uint32_t>(output_id) >= output_tensors.size()) {
     GELOGE(GRAPH_FAILED, "Node output is not registered. node_id = %ld, output index = %d", node_id, output_id);
     return GRAPH_FAILED;
@@ -112,14 +248,13 @@ graphStatus RuntimeInferenceContext::GetTensor(int64_t node_id, int output_id, G
     return GRAPH_PARAM_INVALID;
   }
 
-  std::lock_guard<std::mutex> lk(mu_);
-  auto iter = ge_tensors_.find(node_id);
-  if (iter == ge_tensors_.end()) {
+  auto node_tensors = GetNodeTensors(node_id, false);
+  auto outputs = (node_tensors == nullptr) ? nullptr : std::atomic_load(&node_tensors->outputs);
+  if ((outputs == nullptr) || outputs->ge_tensors.empty()) {
     GELOGE(INTERNAL_ERROR, "Node not register. Id = %ld", node_id);
     return INTERNAL_ERROR;
   }
-
-  auto &output_tensors = iter->second;
+  auto &output_tensors = outputs->ge_tensors;
   if (static_cast<uint32_t>(output_id) >= output_tensors.size()) {
     GELOGE(GRAPH_FAILED, "Node output is not registered. node_id = %ld, output index = %d", node_id, output_id);
     return GRAPH_FAILED;
@@ -129,4 +264,4 @@ graphStatus RuntimeInferenceContext::GetTensor(int64_t node_id, int output_id, G
   tensor = output_tensors[output_id];
   return GRAPH_SUCCESS;
 }
-} // namespace ge
\ No newline at end of file
+} // namespace ge
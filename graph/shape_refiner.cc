@@ -211,7 +211,7 @@ graphStatus UpdateSubGraphDataNodes(const ConstNodePtr &node) {
       return GRAPH_FAILED;
     }
     for (const auto &node_sub : sub_graph->GetDirectNode()) {
-      if (node_sub->GetType() != DATA) {
+      if (node_sub->GetTypeRef() != DATA) {
         continue;
       }
       int ref_i;
@@ -263,10 +263,10 @@ graphStatus FindSubgraphDataAndNetoutput(std::shared_ptr<ComputeGraph> &sub_grap
   auto sub_nodes = sub_graph->GetDirectNode();
   for (size_t i = sub_nodes.size(); i > 0; --i) {
     auto sub_node = sub_nodes.at(i - 1);
-    if (sub_node->GetType() == NETOUTPUT) {
+    if (sub_node->GetTypeRef() == NETOUTPUT) {
       netoutput = sub_node;
     }
-    if (sub_node->GetType() == DATA) {
+    if (sub_node->GetTypeRef() == DATA) {
       if (sub_node->GetOpDesc() == nullptr) {
         return GRAPH_FAILED;
       }
@@ -345,7 +345,7 @@ graphStatus UpdateParentNodeOutTensor(const ConstNodePtr &node) {
     }
   }
 
-  if (node->GetType() == WHILE) {
+  if (node->GetTypeRef() == WHILE) {
     return UpdateParentNodeForWhile(node, ref_data_tensors, ref_out_tensors);
   }
   return UpdateParentNodeForBranch(node, ref_out_tensors);
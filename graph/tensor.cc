@@ -506,7 +506,7 @@ Tensor::Tensor(TensorDesc &&tensor_desc, std::vector<uint8_t> &&data) {
 
 TensorDesc Tensor::GetTensorDesc() const {
   if (impl != nullptr) {
-    return TensorAdapter::GeTensorDesc2TensorDesc(impl->ge_tensor.MutableTensorDesc());
+    return TensorAdapter::GeTensorDesc2TensorDesc(impl->ge_tensor.GetTensorDescRef());
   }
   return TensorDesc();
 }
@@ -618,8 +618,9 @@ graphStatus Tensor::SetData(const std::vector<AscendString> &datas) {
 }
 
 graphStatus Tensor::IsValid() {
-  uint64_t shape_size = GetTensorDesc().GetShape().GetShapeSize();
-  DataType data_type = GetTensorDesc().GetDataType();
+  TensorDesc tensor_desc = GetTensorDesc();
+  uint64_t shape_size = tensor_desc.GetShape().GetShapeSize();
+  DataType data_type = tensor_desc.GetDataType();
   uint32_t type_length;
   bool ret = TypeUtils::GetDataTypeLength(data_type, type_length);
   if (!ret) {
@@ -648,7 +649,7 @@ graphStatus Tensor::IsValid() {
 Tensor Tensor::Clone() const {
   Tensor tensor;
   if (impl != nullptr && tensor.impl != nullptr) {
-    tensor.impl->ge_tensor = impl->ge_tensor.Clone();
+    tensor.impl->ge_tensor = impl->ge_tensor.ShareCopyOnWrite();
   }
   return tensor;
 }
@@ -708,7 +709,7 @@ TensorDesc TensorAdapter::GeTensorDesc2TensorDesc(const GeTensorDesc &ge_tensor_
 GeTensorPtr TensorAdapter::Tensor2GeTensor(const Tensor &tensor) {
   GeTensorPtr ge_tensor;
   if (tensor.impl != nullptr) {
-    ge_tensor = ComGraphMakeShared<GeTensor>(tensor.impl->ge_tensor.Clone());  // lint !e665
+    ge_tensor = ComGraphMakeShared<GeTensor>(tensor.impl->ge_tensor.ShareCopyOnWrite());  // lint !e665
   }
   return ge_tensor;
 }
@@ -716,7 +717,7 @@ GeTensorPtr TensorAdapter::Tensor2GeTensor(const Tensor &tensor) {
 Tensor TensorAdapter::GeTensor2Tensor(const ConstGeTensorPtr &ge_tensor) {
   Tensor tensor;
   if (ge_tensor != nullptr && tensor.impl != nullptr) {
-    tensor.impl->ge_tensor = ge_tensor->Clone();
+    tensor.impl->ge_tensor = ge_tensor->ShareCopyOnWrite();
   }
   return tensor;
 }
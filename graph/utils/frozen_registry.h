@@ -0,0 +1,103 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMMON_GRAPH_UTILS_FROZEN_REGISTRY_H_
+#define COMMON_GRAPH_UTILS_FROZEN_REGISTRY_H_
+
+#include <memory>
+#include <mutex>
+#include <new>
+
+namespace ge {
+///
+/// @brief Immutable lookup table compiled from a registry which rarely changes after startup.
+/// Readers load the frozen table by std::atomic_load without the registry lock. A change of the registry drops it,
+/// and the next freeze builds a new one. A dropped table is freed once the last reader releases it.
+/// Registrations usually run in static initializers, so instances should be function local statics.
+///
+template <typename Table>
+class FrozenRegistry {
+ public:
+  using TablePtr = std::shared_ptr<const Table>;
+
+  /// @return frozen table, nullptr if the registry is not frozen
+  TablePtr Get() const {
+    return std::atomic_load(&frozen_);
+  }
+
+  ///
+  /// @brief Build and publish a new table under the registry lock
+  /// @param [in] build: bool(const Table *last, Table &table), 'last' is the latest built table or nullptr
+  /// @return the new table, nullptr if it can not be built
+  ///
+  template <typename BuildFunc>
+  TablePtr Freeze(const BuildFunc &build) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return FreezeLocked(build);
+  }
+
+  /// @brief Same as Freeze, but the frozen table is returned if there is one
+  template <typename BuildFunc>
+  TablePtr GetOrFreeze(const BuildFunc &build) {
+    TablePtr frozen = Get();
+    if (frozen != nullptr) {
+      return frozen;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    frozen = Get();
+    return (frozen != nullptr) ? frozen : FreezeLocked(build);
+  }
+
+  ///
+  /// @brief Change the registry under the registry lock, the frozen table is dropped if it is changed
+  /// @param [in] update: bool(), returns false if the registry is not changed
+  ///
+  template <typename UpdateFunc>
+  void Update(const UpdateFunc &update) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (update()) {
+      std::atomic_store(&frozen_, TablePtr());
+    }
+  }
+
+  /// @brief Lock for reading the registry itself while it is not frozen
+  std::mutex &GetMutex() {
+    return mutex_;
+  }
+
+ private:
+  template <typename BuildFunc>
+  TablePtr FreezeLocked(const BuildFunc &build) {
+    std::shared_ptr<Table> table(new (std::nothrow) Table());
+    if (table == nullptr) {
+      return nullptr;
+    }
+    if (!build(last_.get(), *table)) {
+      return nullptr;
+    }
+    // only the latest table is kept for the next build to reuse
+    last_ = table;
+    std::atomic_store(&frozen_, last_);
+    return last_;
+  }
+
+  TablePtr frozen_;
+  TablePtr last_;
+  std::mutex mutex_;
+};
+}  // namespace ge
+
+#endif  // COMMON_GRAPH_UTILS_FROZEN_REGISTRY_H_
@@ -15,8 +15,10 @@
  */
 
 #include "graph/utils/ge_ir_utils.h"
+#include <algorithm>
 #include <utility>
 #include "framework/common/debug/ge_log.h"
+#include "graph/utils/parallel_utils.h"
 #include "mmpa/mmpa_api.h"
 
 namespace {
@@ -26,6 +28,8 @@ const char *const kPrefixForInputDesc = "input_desc_attr_";
 const char *const kPrefixForOutputDesc = "output_desc_attr_";
 const char *const kDumpGEGraph = "DUMP_GE_GRAPH";
 const int8_t kMaxRecursionDepth = 10;
+// Each task decodes nodes in a contiguous range, small graphs are not worth the threads
+const size_t kNodesPerDecodeTask = 1024;
 char kDumpGeGraph[MMPA_MAX_PATH] = { 0x00 };
 const int64_t kDumpLevel =
     (mmGetEnv(kDumpGEGraph, kDumpGeGraph, MMPA_MAX_PATH) == EN_OK) ? std::strtol(kDumpGeGraph, nullptr, 10) : ge::OnnxUtils::NO_DUMP;
@@ -791,6 +795,26 @@ bool OnnxUtils::ParseNameIndex(const std::string &node_name_index, std::string &
   return true;
 }
 
+bool OnnxUtils::ParseNameIndex(const std::string &node_name_index, size_t &name_len, int32_t &index) {
+  auto sep = node_name_index.rfind(':');
+  if (sep == std::string::npos) {
+    return false;
+  }
+  name_len = sep;
+  index = static_cast<int32_t>(std::strtol(node_name_index.c_str() + sep + 1, nullptr, 10));
+  return true;
+}
+
+size_t OnnxUtils::NodeNameKeyHash::operator()(const NodeNameKey &key) const {
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < key.len; ++i) {
+    hash ^= static_cast<uint8_t>(key.data[i]);
+    hash *= 1099511628211ULL;
+  }
+  return static_cast<size_t>(hash);
+}
+
 bool OnnxUtils::DecodeNodeLinkImp(const NodeLinkInfo &item, NodePtr &node_ptr) {
   if (node_ptr == nullptr) {
     GELOGE(GRAPH_FAILED, "DecodeNodeLinkImp: node_ptr is nullptr");
@@ -801,8 +825,9 @@ bool OnnxUtils::DecodeNodeLinkImp(const NodeLinkInfo &item, NodePtr &node_ptr) {
     auto src_anchor = node_ptr->GetOutDataAnchor(item.src_out_index);
     auto dst_anchor = item.dst_node->GetInDataAnchor(item.dst_in_index);
     if ((src_anchor == nullptr) || (dst_anchor == nullptr)) {
-      GELOGE(GRAPH_FAILED, "Get data anchor failed %s:%d, %s:%d ", item.src_node_name.c_str(), item.src_out_index,
-             item.dst_node_name.c_str(), item.dst_in_index);
+      GELOGE(GRAPH_FAILED, "Get data anchor failed %.*s:%d, %.*s:%d ", static_cast<int>(item.src_node_name.len),
+             item.src_node_name.data, item.src_out_index, static_cast<int>(item.dst_node_name.len),
+             item.dst_node_name.data, item.dst_in_index);
       return false;
     }
     if (src_anchor->LinkTo(dst_anchor) != GRAPH_SUCCESS) {
@@ -814,8 +839,9 @@ bool OnnxUtils::DecodeNodeLinkImp(const NodeLinkInfo &item, NodePtr &node_ptr) {
     auto src_anchor = node_ptr->GetOutControlAnchor();
     auto dst_anchor = item.dst_node->GetInControlAnchor();
     if ((src_anchor == nullptr) || (dst_anchor == nullptr)) {
-      GELOGE(GRAPH_FAILED, "Get control anchor failed %s:%d, %s:%d ", item.src_node_name.c_str(), item.src_out_index,
-             item.dst_node_name.c_str(), item.dst_in_index);
+      GELOGE(GRAPH_FAILED, "Get control anchor failed %.*s:%d, %.*s:%d ", static_cast<int>(item.src_node_name.len),
+             item.src_node_name.data, item.src_out_index, static_cast<int>(item.dst_node_name.len),
+             item.dst_node_name.data, item.dst_in_index);
       return false;
     }
     if (src_anchor->LinkTo(dst_anchor) != GRAPH_SUCCESS) {
@@ -826,33 +852,35 @@ bool OnnxUtils::DecodeNodeLinkImp(const NodeLinkInfo &item, NodePtr &node_ptr) {
   return true;
 }
 
-bool OnnxUtils::DecodeNodeLink(const std::vector<onnx::NodeProto> &node_proto_vector,
-                               const std::map<std::string, NodePtr> &node_map) {
-  for (const auto &node_proto : node_proto_vector) {
-    const auto &node_name = node_proto.name();
-    auto dst_node = node_map.find(node_name);
+bool OnnxUtils::DecodeNodeLink(const std::vector<const onnx::NodeProto *> &node_proto_vector,
+                               const NodeNameMap &node_map) {
+  for (const auto node_proto : node_proto_vector) {
+    const auto &node_name = node_proto->name();
+    NodeNameKey dst_name_key{node_name.data(), node_name.size()};
+    auto dst_node = node_map.find(dst_name_key);
     if ((dst_node == node_map.end()) || (dst_node->second == nullptr)) {
       GELOGE(GRAPH_FAILED, "destination node: %s find failed or is nullptr", node_name.c_str());
       return false;
     }
     int32_t dst_index = 0;
-    for (const auto &input : node_proto.input()) {
-      std::string input_node_name;
+    for (const auto &input : node_proto->input()) {
+      size_t name_len = 0;
       int32_t index = 0;
-      if (ParseNameIndex(input, input_node_name, index)) {
-        auto item = NodeLinkInfo{input_node_name, index, dst_node->second, dst_index, node_proto.name()};
-        auto src_node = node_map.find(input_node_name);
+      if (ParseNameIndex(input, name_len, index)) {
+        NodeNameKey src_name_key{input.data(), name_len};
+        auto item = NodeLinkInfo{src_name_key, index, dst_node->second, dst_index, dst_name_key};
+        auto src_node = node_map.find(src_name_key);
         if (src_node == node_map.end()) {
-          GELOGE(GRAPH_FAILED, "find src node: %s failed", input_node_name.c_str());
+          GELOGE(GRAPH_FAILED, "find src node: %.*s failed", static_cast<int>(name_len), input.c_str());
           return false;
         }
         auto node_ptr = src_node->second;
         if (node_ptr == nullptr) {
-          GELOGE(GRAPH_FAILED, "src node: %s is nullptr", input_node_name.c_str());
+          GELOGE(GRAPH_FAILED, "src node: %.*s is nullptr", static_cast<int>(name_len), input.c_str());
           return false;
         }
         if (!DecodeNodeLinkImp(item, node_ptr)) {
-          GELOGE(GRAPH_FAILED, "DecodeNodeLinkImp node: %s failed", input_node_name.c_str());
+          GELOGE(GRAPH_FAILED, "DecodeNodeLinkImp node: %.*s failed", static_cast<int>(name_len), input.c_str());
           return false;
         }
       }
@@ -1096,6 +1124,26 @@ bool OnnxUtils::DecodeNodeDesc(const onnx::NodeProto *node_proto, OpDescPtr &op_
   return true;
 }
 
+bool OnnxUtils::DecodeNodeDescs(const std::vector<const onnx::NodeProto *> &node_proto_vector,
+                                std::vector<OpDescPtr> &op_descs) {
+  const size_t node_num = node_proto_vector.size();
+  op_descs.assign(node_num, nullptr);
+  // Nodes are independent until they are linked, so the op descs of a range are decoded by one task
+  auto decode_task = [&node_proto_vector, &op_descs, node_num](size_t index) {
+    size_t end = std::min((index + 1) * kNodesPerDecodeTask, node_num);
+    for (size_t i = index * kNodesPerDecodeTask; i < end; ++i) {
+      OpDescPtr op_desc = ComGraphMakeShared<OpDesc>();
+      if (!DecodeNodeDesc(node_proto_vector[i], op_desc)) {
+        GELOGE(GRAPH_FAILED, "Decode node desc %s failed ", node_proto_vector[i]->name().c_str());
+        return false;
+      }
+      op_descs[i] = op_desc;
+    }
+    return true;
+  };
+  return ParallelFor((node_num + kNodesPerDecodeTask - 1) / kNodesPerDecodeTask, 0, decode_task);
+}
+
 bool OnnxUtils::DecodeGraph(int recursion_depth, const onnx::GraphProto &graph_proto, ComputeGraphPtr &graph) {
   if (recursion_depth > kMaxRecursionDepth) {
     GELOGE(GRAPH_FAILED, "DecodeGraph: recursion depth is too large, abort");
@@ -1106,8 +1154,8 @@ bool OnnxUtils::DecodeGraph(int recursion_depth, const onnx::GraphProto &graph_p
   GE_CHK_BOOL_EXEC(graph != nullptr, return false, "ComputeGraph make shared failed");
   /// 1. Decode all nodes first, node should include input
   /// and output nodes and nodes which represent sub graphs
-  std::map<std::string, NodePtr> node_map;
-  std::vector<onnx::NodeProto> node_proto_vector;
+  std::vector<const onnx::NodeProto *> node_proto_vector;
+  node_proto_vector.reserve(graph_proto.node_size());
   for (const auto &node_proto : graph_proto.node()) {
     // a. nodes represent sub graphs
     if (node_proto.op_type() == kNodeTypeForSubgraph) {
@@ -1124,17 +1172,22 @@ bool OnnxUtils::DecodeGraph(int recursion_depth, const onnx::GraphProto &graph_p
       }
       // b. direct nodes in graph
     } else {
-      node_proto_vector.push_back(node_proto);
-      OpDescPtr op_desc = ComGraphMakeShared<OpDesc>();
-      // b.1 For node desc
-      if (!DecodeNodeDesc(&node_proto, op_desc)) {
-        GELOGE(GRAPH_FAILED, "Decode node desc %s failed ", node_proto.name().c_str());
-        return false;
-      }
-      auto node = graph->AddNode(op_desc);
-      node_map.insert(std::make_pair(node_proto.name(), node));
+      node_proto_vector.push_back(&node_proto);
     }
   }
+  // b.1 For node desc
+  std::vector<OpDescPtr> op_descs;
+  if (!DecodeNodeDescs(node_proto_vector, op_descs)) {
+    return false;
+  }
+  // Keys refer to names in graph_proto, which outlives node_map
+  NodeNameMap node_map;
+  node_map.reserve(node_proto_vector.size());
+  for (size_t i = 0; i < node_proto_vector.size(); ++i) {
+    auto node = graph->AddNode(op_descs[i]);
+    const auto &node_name = node_proto_vector[i]->name();
+    node_map.insert(std::make_pair(NodeNameKey{node_name.data(), node_name.size()}, node));
+  }
   /// We get all nodes in graph here
   /// b.2 For node link
   if (!DecodeNodeLink(node_proto_vector, node_map)) {
@@ -1145,7 +1198,7 @@ bool OnnxUtils::DecodeGraph(int recursion_depth, const onnx::GraphProto &graph_p
   // 2. Add inputs nodes for graph
   for (const auto &input : graph_proto.input()) {
     const auto &input_node_name = input.name();
-    auto input_node_item = node_map.find(input_node_name);
+    auto input_node_item = node_map.find(NodeNameKey{input_node_name.data(), input_node_name.size()});
     if (input_node_item == node_map.end()) {
       GELOGE(GRAPH_FAILED, "cannot find graph's input node %s in node_", input_node_name.c_str());
       return false;
@@ -1156,7 +1209,7 @@ bool OnnxUtils::DecodeGraph(int recursion_depth, const onnx::GraphProto &graph_p
   // 3. Add outputs nodes for graph
   for (const auto &output : graph_proto.output()) {
     const auto &output_node_name = output.name();
-    auto output_node_item = node_map.find(output_node_name);
+    auto output_node_item = node_map.find(NodeNameKey{output_node_name.data(), output_node_name.size()});
     if (output_node_item == node_map.end()) {
       GELOGE(GRAPH_FAILED, "cannot find graph's output node %s in node_", output_node_name.c_str());
       return false;
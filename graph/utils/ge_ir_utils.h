@@ -36,6 +36,7 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -156,18 +157,34 @@ class OnnxUtils {
   static bool EncodeGraph(const ConstComputeGraphPtr &graph, ge::onnx::GraphProto *graph_proto);
 
   /// Part 2: from ONNX Protobuf convert to IR
+  /// Node name referring to chars owned by the graph proto being decoded, so lookups copy nothing
+  struct NodeNameKey {
+    const char *data;
+    size_t len;
+    bool operator==(const NodeNameKey &other) const {
+      return (len == other.len) && (std::char_traits<char>::compare(data, other.data, len) == 0);
+    }
+  };
+  struct NodeNameKeyHash {
+    size_t operator()(const NodeNameKey &key) const;
+  };
+  using NodeNameMap = std::unordered_map<NodeNameKey, NodePtr, NodeNameKeyHash>;
+
   /// Describes node's link relationships
   struct NodeLinkInfo {
-    std::string src_node_name;
+    NodeNameKey src_node_name;
     int32_t src_out_index;
     NodePtr dst_node;
     int32_t dst_in_index;
-    std::string dst_node_name;
+    NodeNameKey dst_node_name;
   };
 
   // Parse node name and index
   static bool ParseNameIndex(const std::string &node_name_index, std::string &node_name, int32_t &index);
 
+  // Parse node name and index in place, node name is the first `name_len` chars of `node_name_index`
+  static bool ParseNameIndex(const std::string &node_name_index, size_t &name_len, int32_t &index);
+
   static ge::DataType DecodeDataType(ge::onnx::TensorProto_DataType data_type);
 
   static void DecodeAttribute(const ge::onnx::AttributeProto &attr_proto, std::vector<std::string> &strings);
@@ -196,11 +213,15 @@ class OnnxUtils {
 
   static bool DecodeNodeLinkImp(const NodeLinkInfo &item, NodePtr &node_ptr);
 
-  static bool DecodeNodeLink(const std::vector<ge::onnx::NodeProto> &node_proto_vector,
-                             const std::map<std::string, NodePtr> &node_map);
+  static bool DecodeNodeLink(const std::vector<const ge::onnx::NodeProto *> &node_proto_vector,
+                             const NodeNameMap &node_map);
 
   static bool DecodeNodeDesc(const ge::onnx::NodeProto *node_proto, OpDescPtr &node);
 
+  // Decode op descs of independent nodes, in parallel for large graphs
+  static bool DecodeNodeDescs(const std::vector<const ge::onnx::NodeProto *> &node_proto_vector,
+                              std::vector<OpDescPtr> &op_descs);
+
   static bool DecodeGraph(int recursion_depth, const ge::onnx::GraphProto &graph_proto, ComputeGraphPtr &graph);
 };
 }  // namespace ge
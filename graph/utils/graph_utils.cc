@@ -36,6 +36,7 @@
 #include "utils/attr_utils.h"
 #include "utils/ge_ir_utils.h"
 #include "utils/node_utils.h"
+#include "utils/parallel_utils.h"
 #include "debug/ge_op_types.h"
 #include "external/ge/ge_api_types.h"
 #include "graph/debug/ge_attr_define.h"
@@ -1550,9 +1551,9 @@ ComputeGraphPtr GraphUtils::CloneGraph(const ComputeGraphPtr &graph, const std::
     GE_CHK_BOOL_EXEC(node != nullptr, return nullptr, "Add node[%s] to graph failed", op_desc->GetName().c_str());
     all_new_nodes[node->GetName()] = node;
 
-    if (node->GetType() == DATA) {
+    if (node->GetTypeRef() == DATA) {
       input_nodes.emplace_back(node);
-    } else if (node->GetType() == NETOUTPUT) {
+    } else if (node->GetTypeRef() == NETOUTPUT) {
       output_nodes.emplace_back(node);
     }
   }
@@ -1563,14 +1564,8 @@ ComputeGraphPtr GraphUtils::CloneGraph(const ComputeGraphPtr &graph, const std::
     }
   }
 
-  std::string session_graph_id;
-  if (AttrUtils::GetStr(*graph, ATTR_NAME_SESSION_GRAPH_ID, session_graph_id)) {
-    bool ret = AttrUtils::SetStr(*new_graph, ATTR_NAME_SESSION_GRAPH_ID, session_graph_id);
-    if (!ret) {
-      GELOGE(GRAPH_FAILED, "Set attr ATTR_NAME_SESSION_GRAPH_ID failed.");
-      return nullptr;
-    }
-  }
+  // graph attrs, ATTR_NAME_SESSION_GRAPH_ID included, are shared until either graph changes them
+  new_graph->ShareAttrsFrom(*graph);
 
   // copy info of output nodes from old graph to new graph.
   std::vector<std::pair<NodePtr, int32_t>> out_nodes_info = graph->GetGraphOutNodesInfo();
@@ -2844,7 +2839,7 @@ void CompleteGraphBuilder::PostProcess(graphStatus &error_code, std::string &err
 
   // refresh node name
   for (const NodePtr &node : owner_graph_->GetDirectNode()) {
-    if ((node->GetOpDesc() == nullptr) || (node->GetType() == VARIABLE) || (node->GetType() == VARIABLEV2)) {
+    if ((node->GetOpDesc() == nullptr) || (node->GetTypeRef() == VARIABLE) || (node->GetTypeRef() == VARIABLEV2)) {
       continue;
     }
     node->GetOpDesc()->SetName(owner_graph_->GetName() + "/" + node->GetName());
@@ -3026,4 +3021,234 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus GraphUtils::Topologic
   return GRAPH_SUCCESS;
 }
 
+///
+/// @brief Preallocate storage for nodes and edges
+/// @param [in] node_num
+/// @param [in] edge_num
+/// @return BulkGraphBuilder
+///
+BulkGraphBuilder &BulkGraphBuilder::Reserve(size_t node_num, size_t edge_num) {
+  node_defs_.reserve(node_num);
+  node_attrs_.reserve(node_num);
+  data_edges_.reserve(edge_num);
+  return *this;
+}
+
+///
+/// @brief Add node with anonymous input and output tensors, the op desc is created in Build
+/// @param [in] name
+/// @param [in] type
+/// @param [in] input_num
+/// @param [in] output_num
+/// @return index of the node
+///
+uint32_t BulkGraphBuilder::AddNode(const std::string &name, const std::string &type, uint32_t input_num,
+                                   uint32_t output_num) {
+  node_defs_.emplace_back(NodeDef{name, type, input_num, output_num, nullptr});
+  node_attrs_.emplace_back();
+  return static_cast<uint32_t>(node_defs_.size() - 1);
+}
+
+///
+/// @brief Add node with an existing op desc
+/// @param [in] op_desc
+/// @return index of the node
+///
+uint32_t BulkGraphBuilder::AddNode(const OpDescPtr &op_desc) {
+  if (op_desc == nullptr) {
+    GE_LOGE("op_desc is NULL.");
+    has_null_op_desc_ = true;
+  }
+  node_defs_.emplace_back(NodeDef{"", "", 0, 0, op_desc});
+  node_attrs_.emplace_back();
+  return static_cast<uint32_t>(node_defs_.size() - 1);
+}
+
+///
+/// @brief Set attr of the node
+/// @param [in] node_index
+/// @param [in] attr_name
+/// @param [in] attr_value
+/// @return BulkGraphBuilder
+///
+BulkGraphBuilder &BulkGraphBuilder::SetAttr(uint32_t node_index, const std::string &attr_name,
+                                            const GeAttrValue &attr_value) {
+  if (node_index >= node_attrs_.size()) {
+    GELOGW("Set attr %s failed: node index %u out of range %zu.", attr_name.c_str(), node_index,
+           node_attrs_.size());
+    return *this;
+  }
+  node_attrs_[node_index].emplace_back(attr_name, attr_value);
+  return *this;
+}
+
+///
+/// @brief Add data-edge by node index and anchor index
+/// @param [in] src_node
+/// @param [in] out_anchor_ind
+/// @param [in] dst_node
+/// @param [in] in_anchor_ind
+/// @return BulkGraphBuilder
+///
+BulkGraphBuilder &BulkGraphBuilder::AddDataEdge(uint32_t src_node, uint32_t out_anchor_ind, uint32_t dst_node,
+                                                uint32_t in_anchor_ind) {
+  data_edges_.emplace_back(EdgeDef{src_node, out_anchor_ind, dst_node, in_anchor_ind});
+  return *this;
+}
+
+///
+/// @brief Add ctrl-edge by node index
+/// @param [in] src_node
+/// @param [in] dst_node
+/// @return BulkGraphBuilder
+///
+BulkGraphBuilder &BulkGraphBuilder::AddControlEdge(uint32_t src_node, uint32_t dst_node) {
+  ctrl_edges_.emplace_back(src_node, dst_node);
+  return *this;
+}
+
+///
+/// @brief Create op descs of nodes in [begin, end)
+/// @param [in] begin
+/// @param [in] end
+/// @return graphStatus
+///
+graphStatus BulkGraphBuilder::CreateOpDescs(size_t begin, size_t end) {
+  for (size_t i = begin; i < end; ++i) {
+    auto &node_def = node_defs_[i];
+    if (node_def.op_desc == nullptr) {
+      node_def.op_desc = ComGraphMakeShared<OpDesc>(node_def.name, node_def.type);
+      if (node_def.op_desc == nullptr) {
+        GELOGE(GRAPH_FAILED, "Create op desc %s failed.", node_def.name.c_str());
+        return GRAPH_FAILED;
+      }
+      for (uint32_t j = 0; j < node_def.input_num; ++j) {
+        GE_CHK_BOOL_RET_STATUS(node_def.op_desc->AddInputDesc(GeTensorDesc()) == GRAPH_SUCCESS, GRAPH_FAILED,
+                               "Add input desc of %s failed.", node_def.name.c_str());
+      }
+      for (uint32_t j = 0; j < node_def.output_num; ++j) {
+        GE_CHK_BOOL_RET_STATUS(node_def.op_desc->AddOutputDesc(GeTensorDesc()) == GRAPH_SUCCESS, GRAPH_FAILED,
+                               "Add output desc of %s failed.", node_def.name.c_str());
+      }
+    }
+    for (const auto &attr : node_attrs_[i]) {
+      GE_CHK_BOOL_RET_STATUS(node_def.op_desc->SetAttr(attr.first, attr.second) == GRAPH_SUCCESS, GRAPH_FAILED,
+                             "Set attr %s of %s failed.", attr.first.c_str(), node_def.op_desc->GetName().c_str());
+    }
+  }
+  return GRAPH_SUCCESS;
+}
+
+///
+/// @brief Build graph
+/// @param [out] error_code
+/// @param [out] error_msg
+/// @param [in] thread_num
+/// @return ComputeGraphPtr
+///
+ComputeGraphPtr BulkGraphBuilder::Build(graphStatus &error_code, std::string &error_msg, uint32_t thread_num) {
+  error_code = GRAPH_SUCCESS;
+  if (has_null_op_desc_) {
+    error_code = GRAPH_FAILED;
+    error_msg = "op_desc is NULL.";
+    return nullptr;
+  }
+  auto graph = ComGraphMakeShared<ComputeGraph>(name_);
+  if (graph == nullptr) {
+    error_code = GRAPH_FAILED;
+    error_msg = "graph is NULL.";
+    return nullptr;
+  }
+
+  const size_t node_num = node_defs_.size();
+  // Each task creates op descs in a contiguous range, small graphs are not worth the threads
+  const size_t kNodesPerTask = 1024;
+  size_t task_num = (node_num + kNodesPerTask - 1) / kNodesPerTask;
+  auto create_task = [this, node_num, kNodesPerTask](size_t index) {
+    size_t begin = index * kNodesPerTask;
+    return CreateOpDescs(begin, std::min(begin + kNodesPerTask, node_num)) == GRAPH_SUCCESS;
+  };
+  if (!ParallelFor(task_num, thread_num, create_task)) {
+    error_code = GRAPH_FAILED;
+  }
+  if (error_code != GRAPH_SUCCESS) {
+    error_msg = "Create op descs failed.";
+    return nullptr;
+  }
+
+  nodes_.clear();
+  nodes_.reserve(node_num);
+  for (auto &node_def : node_defs_) {
+    NodePtr node = graph->AddNode(node_def.op_desc);
+    if (node == nullptr) {
+      error_code = GRAPH_FAILED;
+      error_msg = "Add node " + node_def.op_desc->GetName() + " failed.";
+      return nullptr;
+    }
+    nodes_.emplace_back(node);
+  }
+
+  BuildEdges(error_code, error_msg);
+  if (error_code != GRAPH_SUCCESS) {
+    return nullptr;
+  }
+  GELOGD("Build graph %s with %zu nodes, %zu data-edges, %zu ctrl-edges succ.", name_.c_str(), node_num,
+         data_edges_.size(), ctrl_edges_.size());
+  return graph;
+}
+
+///
+/// @brief Link data-edges and ctrl-edges between built nodes
+/// @param [out] error_code
+/// @param [out] error_msg
+/// @return void
+///
+void BulkGraphBuilder::BuildEdges(graphStatus &error_code, std::string &error_msg) {
+  for (const auto &edge : data_edges_) {
+    if ((edge.src_node >= nodes_.size()) || (edge.dst_node >= nodes_.size())) {
+      error_code = GRAPH_FAILED;
+      error_msg = "Add data-edge " + std::to_string(edge.src_node) + "->" + std::to_string(edge.dst_node) +
+                  " failed: node not exist in graph.";
+      return;
+    }
+    const auto &src_node = nodes_[edge.src_node];
+    const auto &dst_node = nodes_[edge.dst_node];
+    if (GraphUtils::AddEdge(src_node->GetOutDataAnchor(static_cast<int>(edge.src_index)),
+                            dst_node->GetInDataAnchor(static_cast<int>(edge.dst_index))) != GRAPH_SUCCESS) {
+      error_code = GRAPH_FAILED;
+      error_msg = "Add data-edge " + src_node->GetName() + ":" + std::to_string(edge.src_index) + "->" +
+                  dst_node->GetName() + ":" + std::to_string(edge.dst_index) + " failed.";
+      return;
+    }
+  }
+
+  for (const auto &edge : ctrl_edges_) {
+    if ((edge.first >= nodes_.size()) || (edge.second >= nodes_.size())) {
+      error_code = GRAPH_FAILED;
+      error_msg = "Add ctrl-edge " + std::to_string(edge.first) + "->" + std::to_string(edge.second) +
+                  " failed: node not exist in graph.";
+      return;
+    }
+    const auto &src_node = nodes_[edge.first];
+    const auto &dst_node = nodes_[edge.second];
+    if (GraphUtils::AddEdge(src_node->GetOutControlAnchor(), dst_node->GetInControlAnchor()) != GRAPH_SUCCESS) {
+      error_code = GRAPH_FAILED;
+      error_msg = "Add ctrl-edge " + src_node->GetName() + "->" + dst_node->GetName() + " failed.";
+      return;
+    }
+  }
+}
+
+///
+/// @brief Get node by index after build
+/// @param [in] node_index
+/// @return NodePtr
+///
+NodePtr BulkGraphBuilder::GetNode(uint32_t node_index) const {
+  if (node_index >= nodes_.size()) {
+    GE_LOGE("node index %u out of range %zu.", node_index, nodes_.size());
+    return nullptr;
+  }
+  return nodes_[node_index];
+}
 }  // namespace ge
@@ -614,11 +614,11 @@ graphStatus NodeUtils::GetInputConstData(const Node &node,
     return GRAPH_SUCCESS;
   } else if (peer_op_type == DATA) {
     auto parent_node = NodeUtils::GetParentInput(peer_node);
-    while ((parent_node != nullptr) && (parent_node->GetType() == DATA)) {
+    while ((parent_node != nullptr) && (parent_node->GetTypeRef() == DATA)) {
       parent_node = NodeUtils::GetParentInput(parent_node);
     }
     if ((parent_node != nullptr)
-        && ((parent_node->GetType() == CONSTANT) || (parent_node->GetType() == CONSTANTOP))) {
+        && ((parent_node->GetTypeRef() == CONSTANT) || (parent_node->GetTypeRef() == CONSTANTOP))) {
       if (!AttrUtils::MutableTensor(parent_node->GetOpDesc(), ATTR_NAME_WEIGHTS, ge_tensor)) {
         GELOGW("get attr name %s failed.", ATTR_NAME_WEIGHTS.c_str());
         return GRAPH_FAILED;
@@ -627,10 +627,10 @@ graphStatus NodeUtils::GetInputConstData(const Node &node,
     }
   }
   // Try get from runtime inference context
-  auto session_id = std::to_string(GetContext().SessionId());
+  auto session_id = GetContext().SessionId();
   RuntimeInferenceContext *runtime_infer_ctx = nullptr;
   if (RuntimeInferenceContext::GetContext(session_id, &runtime_infer_ctx) == GRAPH_SUCCESS) {
-    GELOGD("To get constant from runtime inference context. session_id = %s", session_id.c_str());
+    GELOGD("To get constant from runtime inference context. session_id = %lu", session_id);
     auto ret = runtime_infer_ctx->GetTensor(peer_node->GetOpDesc()->GetId(),
                                             out_data_anchor->GetIdx(), ge_tensor);
     if (ret == GRAPH_SUCCESS) {
@@ -643,8 +643,9 @@ graphStatus NodeUtils::GetInputConstData(const Node &node,
 
 
 std::string NodeUtils::GetNodeType(const Node &node) {
-  if (node.GetType() != FRAMEWORKOP) {
-    return node.GetType();
+  const auto &node_type = node.GetTypeRef();
+  if (node_type != FRAMEWORKOP) {
+    return node_type;
   }
 
   std::string type;
@@ -744,7 +745,7 @@ bool NodeUtils::IsSubgraphInput(const NodePtr &node) {
 ///
 bool NodeUtils::IsSubgraphOutput(const NodePtr &node) {
   if ((node == nullptr) || (node->GetOpDesc() == nullptr) ||
-      (node->GetOwnerComputeGraph()->GetParentNode() == nullptr) || (node->GetType() != NETOUTPUT)) {
+      (node->GetOwnerComputeGraph()->GetParentNode() == nullptr) || (node->GetTypeRef() != NETOUTPUT)) {
     return false;
   }
 
@@ -832,7 +833,7 @@ bool NodeUtils::IsWhileVaryingInput(const ge::NodePtr &node) {
   if (node == nullptr) {
     return false;
   }
-  if (node->GetType() != DATA) {
+  if (node->GetTypeRef() != DATA) {
     return false; // not input_node for subgraph
   }
 
@@ -841,7 +842,7 @@ bool NodeUtils::IsWhileVaryingInput(const ge::NodePtr &node) {
     return false; // root graph
   }
 
-  if (kWhileOpTypes.count(parent_node->GetType()) == 0) {
+  if (kWhileOpTypes.count(parent_node->GetTypeRef()) == 0) {
     return false; // not input_node for while subgraph
   }
 
@@ -852,7 +853,7 @@ bool NodeUtils::IsWhileVaryingInput(const ge::NodePtr &node) {
   }
   bool varying_flag = true;
   for (const auto &item : node->GetOutDataNodesAndAnchors()) {
-    if (item.first->GetType() != NETOUTPUT) {
+    if (item.first->GetTypeRef() != NETOUTPUT) {
       continue;
     }
     OpDescPtr op_desc = item.first->GetOpDesc();
@@ -881,12 +882,12 @@ bool NodeUtils::GetConstOpType(const NodePtr &node, std::string &type) {
     return false;
   }
 
-  if ((node->GetType() == CONSTANT) || (node->GetType() == CONSTANTOP)) {
+  if ((node->GetTypeRef() == CONSTANT) || (node->GetTypeRef() == CONSTANTOP)) {
     type = node->GetType();
     return true;
   }
 
-  if (node->GetType() != DATA) {
+  if (node->GetTypeRef() != DATA) {
     return false;   // not subgraph input node
   }
 
@@ -1038,13 +1039,13 @@ ConstNodePtr NodeUtils::GetNodeFromOperator(const Operator &oprt) {
 std::string NodeUtils::GetInConstNodeTypeCrossSubgraph(const NodePtr &node) {
   NodePtr input_node = node;
   while (input_node != nullptr) {
-    if (input_node->GetType() != DATA) {
+    if (input_node->GetTypeRef() != DATA) {
       return input_node->GetType();
     }
 
     auto owner_graph = input_node->GetOwnerComputeGraph();
     auto parent_node = owner_graph->GetParentNode();
-    if ((parent_node == nullptr) || (kWhileOpTypes.count(parent_node->GetType()) > 0)) {
+    if ((parent_node == nullptr) || (kWhileOpTypes.count(parent_node->GetTypeRef()) > 0)) {
       return node->GetType();       // not in subgraph or while subgraph.
     }
 
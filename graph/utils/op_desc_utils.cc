@@ -202,15 +202,15 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY vector<ge::NodePtr> OpDescUtils::
       if (in_node == nullptr) {
         break;
       }
-      if ((in_node->GetType() == CONSTANT) || (in_node->GetType() == CONSTANTOP)) {
+      if ((in_node->GetTypeRef() == CONSTANT) || (in_node->GetTypeRef() == CONSTANTOP)) {
         ret.push_back(in_node);
         break;
-      } else if (in_node->GetType() == DATA) {
+      } else if (in_node->GetTypeRef() == DATA) {
         if (NodeUtils::IsWhileVaryingInput(in_node)) {
           break;
         }
         in_node = NodeUtils::GetParentInput(in_node);
-      } else if ((in_node->GetType() == ENTER) || (in_node->GetType() == REFENTER)) {
+      } else if ((in_node->GetTypeRef() == ENTER) || (in_node->GetTypeRef() == REFENTER)) {
         bool is_constant = false;
         (void)AttrUtils::GetBool(in_node->GetOpDesc(), ENTER_ATTR_CONSTANT_FLAG, is_constant);
         if (!is_constant) {
@@ -295,7 +295,7 @@ GeTensorDesc OpDescUtils::GetNonConstInputTensorDesc(const ge::Node &node, size_
       if (owner_node == nullptr) {
         continue;
       }
-      if (owner_node->GetType() == CONSTANT) {
+      if (owner_node->GetTypeRef() == CONSTANT) {
         continue;
       }
       if (index_non_const == i) {
@@ -336,7 +336,7 @@ bool OpDescUtils::GetNonConstInputIndex(const ge::Node &node, const size_t index
       if (owner_node == nullptr) {
         continue;
       }
-      if (owner_node->GetType() == CONSTANT) {
+      if (owner_node->GetTypeRef() == CONSTANT) {
         continue;
       }
       if (index_non_const == i) {
@@ -374,7 +374,7 @@ bool OpDescUtils::IsNonConstInput(const ge::Node &node, const size_t index) {
         if (owner_node == nullptr) {
           break;
         }
-        ret = (owner_node->GetType() != CONSTANT);
+        ret = (owner_node->GetTypeRef() != CONSTANT);
       }
     }
   }
@@ -414,7 +414,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY vector<ge::GeTensorDesc> OpDescUt
       if (out_anchor == nullptr || out_anchor->GetOwnerNode()->GetOpDesc() == nullptr) {
         continue;
       }
-      if (out_anchor->GetOwnerNode()->GetOpDesc()->GetType() != CONSTANT) {
+      if (out_anchor->GetOwnerNode()->GetOpDesc()->GetTypeRef() != CONSTANT) {
         ret.push_back(node->GetOpDesc()->GetInputDesc(in_anchor->GetIdx()));
       }
     }
@@ -430,17 +430,17 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY vector<ge::NodePtr> OpDescUtils::
     if (out_anchor == nullptr) continue;
 
     auto in_node = out_anchor->GetOwnerNode();
-    if (in_node->GetType() == CONSTANT) {
+    if (in_node->GetTypeRef() == CONSTANT) {
       ret.push_back(in_node);
-    } else if (in_node->GetType() == SWITCH && node.GetType() == MATMUL) {
+    } else if (in_node->GetTypeRef() == SWITCH && node.GetTypeRef() == MATMUL) {
       // const --> switch --> matmul
       auto switch_input = GetConstInputs(*in_node);
       if (switch_input.size() > 0) {
         ret.insert(ret.end(), switch_input.begin(), switch_input.end());
       }
-    } else if (in_node->GetType() == DATA) {
+    } else if (in_node->GetTypeRef() == DATA) {
       auto parent = NodeUtils::GetParentInput(in_node);
-      if ((parent != nullptr) && (parent->GetType() == CONSTANT)) {
+      if ((parent != nullptr) && (parent->GetTypeRef() == CONSTANT)) {
         ret.push_back(parent);
       }
     }
@@ -454,7 +454,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY vector<GeTensorPtr> OpDescUtils::
   GE_CHK_BOOL_EXEC(op_desc != nullptr, return ret, "op_desc is nullptr!");
   // Place holder operator, try to get the weight from parent node
   // when parent node is const operator
-  if (node.GetType() == PLACEHOLDER) {
+  if (node.GetTypeRef() == PLACEHOLDER) {
     std::string parent_op;
     (void) AttrUtils::GetStr(op_desc, "parentOpType", parent_op);
     // This if judgment is necessary because the current subgraph optimization is multithreaded
@@ -469,7 +469,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY vector<GeTensorPtr> OpDescUtils::
     }
   }
   // Const operator, take the weight directly
-  if (op_desc->GetType() == CONSTANT || (op_desc->GetType() == CONSTANTOP)) {
+  if (op_desc->GetTypeRef() == CONSTANT || (op_desc->GetTypeRef() == CONSTANTOP)) {
     auto weight = MutableWeights(op_desc);
     if (weight == nullptr) {
       GELOGI("const op has no weight, op name:%s", node.GetName().c_str());
@@ -479,7 +479,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY vector<GeTensorPtr> OpDescUtils::
     return ret;
   }
 
-  if (node.GetType() == DATA) {
+  if (node.GetTypeRef() == DATA) {
     auto parent = NodeUtils::GetParentInput(node);
     if ((parent != nullptr) && NodeUtils::IsConst(*parent)) {
       auto weight = MutableWeights(parent->GetOpDesc());
@@ -516,7 +516,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY vector<GeTensorPtr> OpDescUtils::
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus
 OpDescUtils::SetWeights(ge::Node &node, const vector<ge::GeTensorPtr> &weights) {
   GE_CHK_BOOL_EXEC(node.GetOpDesc() != nullptr, return GRAPH_PARAM_INVALID, "node.GetOpDesc is nullptr!");
-  if (node.GetOpDesc()->GetType() == CONSTANT) {
+  if (node.GetOpDesc()->GetTypeRef() == CONSTANT) {
     if (weights.size() == CONST_OP_NORMAL_WEIGHT_SIZE) {
       return SetWeights(node.GetOpDesc(), weights[0]);
     }
@@ -564,7 +564,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus
 OpDescUtils::SetWeights(ge::Node &node, const map<int, ge::GeTensorPtr> &weights_map) {
   GE_CHECK_NOTNULL(node.GetOpDesc());
   // 1. node is const
-  if (node.GetOpDesc()->GetType() == CONSTANT) {
+  if (node.GetOpDesc()->GetTypeRef() == CONSTANT) {
     if (weights_map.size() == CONST_OP_NORMAL_WEIGHT_SIZE) {
       return SetWeights(node.GetOpDesc(), weights_map.begin()->second);
     }
@@ -582,7 +582,7 @@ OpDescUtils::SetWeights(ge::Node &node, const map<int, ge::GeTensorPtr> &weights
         GELOGE(GRAPH_PARAM_INVALID, "op %s [%d]'s input node is null", node.GetName().c_str(), pair.first);
         return GRAPH_PARAM_INVALID;
       }
-      if (peer_node->GetType() != CONSTANT) {
+      if (peer_node->GetTypeRef() != CONSTANT) {
         GELOGE(GRAPH_PARAM_INVALID,
                " op %s [%d]'s input node should be const, but is %s type:%s ", node.GetName().c_str(),
                pair.first, peer_node->GetName().c_str(), peer_node->GetType().c_str());
@@ -0,0 +1,121 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph/utils/op_type_utils.h"
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ge {
+namespace {
+const size_t kInitSlotNum = 1024U;
+
+struct OpTypeEntry {
+  std::string type;
+  size_t hash;
+  OpTypeId type_id;
+};
+
+// Open addressing hash set of the interned types. A slot is written once, from null to the entry, and never
+// cleared, so readers can probe it without a lock while a new type is being added.
+struct OpTypeSlots {
+  explicit OpTypeSlots(size_t slot_num) : mask(slot_num - 1U), slots(new std::atomic<const OpTypeEntry *>[slot_num]) {
+    for (size_t i = 0U; i < slot_num; ++i) {
+      slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  const OpTypeEntry *Find(const std::string &type, size_t hash) const {
+    for (size_t i = hash & mask;; i = (i + 1U) & mask) {
+      const OpTypeEntry *entry = slots[i].load(std::memory_order_acquire);
+      if ((entry == nullptr) || ((entry->hash == hash) && (entry->type == type))) {
+        return entry;
+      }
+    }
+  }
+
+  void Insert(const OpTypeEntry *entry) {
+    size_t i = entry->hash & mask;
+    while (slots[i].load(std::memory_order_relaxed) != nullptr) {
+      i = (i + 1U) & mask;
+    }
+    slots[i].store(entry, std::memory_order_release);
+  }
+
+  size_t mask;
+  std::unique_ptr<std::atomic<const OpTypeEntry *>[]> slots;
+};
+
+struct OpTypeTable {
+  OpTypeTable() {
+    all_slots.emplace_back(new OpTypeSlots(kInitSlotNum));
+    current.store(all_slots.back().get(), std::memory_order_release);
+  }
+  std::atomic<const OpTypeSlots *> current{nullptr};
+  // guards the members below, only taken by a type that is not interned yet
+  std::mutex mutex;
+  // deque never moves its elements, so the slots can point to them
+  std::deque<OpTypeEntry> entries;
+  // slots replaced by a bigger one are kept, a reader may still be probing them. They add up to less than
+  // the size of the current slots.
+  std::vector<std::unique_ptr<OpTypeSlots>> all_slots;
+};
+
+OpTypeTable &GetOpTypeTable() {
+  static OpTypeTable table;
+  return table;
+}
+}  // namespace
+
+const OpTypeId OpTypeUtils::kEmptyOpTypeId;
+
+OpTypeId OpTypeUtils::GetOpTypeId(const std::string &type) {
+  if (type.empty()) {
+    return kEmptyOpTypeId;
+  }
+  auto &table = GetOpTypeTable();
+  const size_t hash = std::hash<std::string>()(type);
+  const OpTypeEntry *entry = table.current.load(std::memory_order_acquire)->Find(type, hash);
+  if (entry != nullptr) {
+    return entry->type_id;
+  }
+
+  std::lock_guard<std::mutex> lock(table.mutex);
+  OpTypeSlots *slots = table.all_slots.back().get();
+  entry = slots->Find(type, hash);
+  if (entry != nullptr) {
+    return entry->type_id;
+  }
+  const OpTypeId type_id = static_cast<OpTypeId>(table.entries.size() + 1U);
+  table.entries.push_back({type, hash, type_id});
+  // keep the load factor under one half, so a probe always ends at a null slot soon
+  if (table.entries.size() * 2U > slots->mask + 1U) {
+    std::unique_ptr<OpTypeSlots> bigger(new OpTypeSlots((slots->mask + 1U) * 2U));
+    for (const auto &interned : table.entries) {
+      bigger->Insert(&interned);
+    }
+    table.all_slots.emplace_back(std::move(bigger));
+    table.current.store(table.all_slots.back().get(), std::memory_order_release);
+  } else {
+    slots->Insert(&table.entries.back());
+  }
+  return type_id;
+}
+}  // namespace ge
@@ -0,0 +1,94 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMMON_GRAPH_UTILS_PARALLEL_UTILS_H_
+#define COMMON_GRAPH_UTILS_PARALLEL_UTILS_H_
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+#include "framework/common/debug/ge_log.h"
+#include "graph/ge_context.h"
+#include "graph/ge_local_context.h"
+
+namespace ge {
+const uint32_t kMaxParallelThreadNum = 16;
+
+///
+/// @brief Run task(0) ... task(task_num - 1) with at most thread_num threads, the calling thread included.
+/// Workers take tasks one by one so tasks of different cost balance out, and no task starts after one failed.
+/// If a worker thread can not be created, its share is taken by the threads already running, and all created
+/// threads are joined before return. Tasks must not throw.
+/// Worker threads start with the options of GetThreadLocalContext() and the session id of GetContext() copied
+/// from the calling thread, so tasks read the same options as they would in a serial run.
+/// @param [in] task_num
+/// @param [in] thread_num: 0 means decided by hardware concurrency, up to kMaxParallelThreadNum
+/// @param [in] task: bool(size_t), returns false on failure
+/// @return true if all tasks succeed
+///
+template <typename TaskFunc>
+bool ParallelFor(size_t task_num, uint32_t thread_num, const TaskFunc &task) {
+  if (thread_num == 0) {
+    thread_num = std::min(std::max(std::thread::hardware_concurrency(), 1U), kMaxParallelThreadNum);
+  }
+  thread_num = static_cast<uint32_t>(std::min(static_cast<size_t>(thread_num), task_num));
+  if (thread_num <= 1) {
+    for (size_t i = 0; i < task_num; ++i) {
+      if (!task(i)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::atomic<size_t> next_task(0);
+  std::atomic<bool> failed(false);
+  const GEThreadLocalContext caller_context = GetThreadLocalContext();
+  const uint64_t caller_session_id = GetContext().SessionId();
+  auto worker_func = [&task, task_num, &next_task, &failed]() {
+    size_t index = next_task.fetch_add(1);
+    while ((index < task_num) && !failed.load()) {
+      if (!task(index)) {
+        failed.store(true);
+        break;
+      }
+      index = next_task.fetch_add(1);
+    }
+  };
+  std::vector<std::thread> workers;
+  for (uint32_t i = 1; i < thread_num; ++i) {
+    try {
+      workers.emplace_back([&worker_func, &caller_context, caller_session_id]() {
+        GetThreadLocalContext() = caller_context;
+        GetContext().SetSessionId(caller_session_id);
+        worker_func();
+      });
+    } catch (const std::exception &e) {
+      GELOGW("Only %zu of %u worker threads are created: %s", workers.size(), thread_num - 1, e.what());
+      break;
+    }
+  }
+  worker_func();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  return !failed.load();
+}
+}  // namespace ge
+
+#endif  // COMMON_GRAPH_UTILS_PARALLEL_UTILS_H_
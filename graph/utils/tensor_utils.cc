@@ -16,14 +16,18 @@
 
 #include "graph/utils/tensor_utils.h"
 #include <cmath>
+#include <cstring>
 
 #include "debug/ge_log.h"
+#include "debug/ge_util.h"
 #include "framework/common/debug/ge_log.h"
 #include "common/util/error_manager/error_manager.h"
+#include "graph/compute_graph.h"
 #include "graph/ge_tensor.h"
 #include "graph/types.h"
 #include "graph/utils/type_utils.h"
 #include "mmpa/mmpa_api.h"
+#include "proto/ge_ir.pb.h"
 
 namespace ge {
 namespace {
@@ -99,13 +103,15 @@ static bool CheckMultiplyOverflowInt64(const int64_t &a, const int64_t &b) {
 ///
 /// Calculate element num by dims directly.
 /// @param dims dim info
+/// @param dim_num dim num
 /// @param element_cnt element count
 /// @return GRAPH_SUCCESS:success
 ///         other:failed
 ///
-static graphStatus CalcElementCntByDims(const std::vector<int64_t> &dims, int64_t &element_cnt) {
+static graphStatus CalcElementCntByDims(const int64_t *dims, size_t dim_num, int64_t &element_cnt) {
   element_cnt = 1;
-  for (int64_t dim : dims) {
+  for (size_t i = 0; i < dim_num; ++i) {
+    int64_t dim = dims[i];
     if (CheckMultiplyOverflowInt64(element_cnt, dim)) {
       ErrorManager::GetInstance().ATCReportErrMessage(
           "E19013", {"function", "var1", "var2"},
@@ -121,18 +127,19 @@ static graphStatus CalcElementCntByDims(const std::vector<int64_t> &dims, int64_
 ///
 /// Calculate fixed dims element num.
 /// @param dims dim info
+/// @param dim_num dim num
 /// @param fixed_dim_size fixed dim size
 /// @param element_cnt element count
 /// @return GRAPH_SUCCESS:success
 ///         other:failed
 ///
-static graphStatus CalcElementCntOfFixedDims(const std::vector<int64_t> &dims, Format format, uint32_t fixed_dim_size,
-                                             int64_t &element_cnt) {
-  if (dims.size() != fixed_dim_size) {
+static graphStatus CalcElementCntOfFixedDims(const int64_t *dims, size_t dim_num, Format format,
+                                             uint32_t fixed_dim_size, int64_t &element_cnt) {
+  if (dim_num != fixed_dim_size) {
     GELOGW("Format %d(%s) need dim size=%u but %zu, calc as ND.", format,
-            TypeUtils::FormatToSerialString(format).c_str(), fixed_dim_size, dims.size());
+            TypeUtils::FormatToSerialString(format).c_str(), fixed_dim_size, dim_num);
   }
-  return CalcElementCntByDims(dims, element_cnt);
+  return CalcElementCntByDims(dims, dim_num, element_cnt);
 }
 
 ///
@@ -149,17 +156,19 @@ static uint32_t GetDimC0(DataType &data_type) {
 ///
 /// Calculate nc1hwc0 element num.
 /// @param dims dim info
+/// @param dim_num dim num
 /// @param data_type data type
 /// @param element_cnt element count
 /// @return GRAPH_SUCCESS:success
 ///         other:failed
 ///
-static graphStatus CalcElementCntOfNc1hwc0(const std::vector<int64_t> &dims, DataType data_type, int64_t &element_cnt) {
+static graphStatus CalcElementCntOfNc1hwc0(const int64_t *dims, size_t dim_num, DataType data_type,
+                                           int64_t &element_cnt) {
   // When nc1hwc0 dims size = 5, no need split dim c
-  if (dims.size() == kNc1hwc0CalcByDimsSize) {
-    return CalcElementCntByDims(dims, element_cnt);
-  } else if (dims.size() != kDimSize4d) {
-    GELOGE(GRAPH_FAILED, "CalcElementCntOfNc1hwc0 failed as dims.size=%zu is not %u or %u.", dims.size(), kDimSize4d,
+  if (dim_num == kNc1hwc0CalcByDimsSize) {
+    return CalcElementCntByDims(dims, dim_num, element_cnt);
+  } else if (dim_num != kDimSize4d) {
+    GELOGE(GRAPH_FAILED, "CalcElementCntOfNc1hwc0 failed as dims.size=%zu is not %u or %u.", dim_num, kDimSize4d,
            kNc1hwc0CalcByDimsSize);
     return GRAPH_FAILED;
   }
@@ -168,25 +177,26 @@ static graphStatus CalcElementCntOfNc1hwc0(const std::vector<int64_t> &dims, Dat
   // Nc1hwc0 dims is according to nchw, dim c index is 1.
   auto c1 = static_cast<int64_t>(std::ceil(dims[kNchwDimIdxC] * 1.0 / c0));
   // Store dims is split c to c1 and c0.
-  std::vector<int64_t> store_dims = {dims[kNchwDimIdxN], c1, dims[kNchwDimIdxH], dims[kNchwDimIdxW], c0};
-  return CalcElementCntByDims(store_dims, element_cnt);
+  const int64_t store_dims[] = {dims[kNchwDimIdxN], c1, dims[kNchwDimIdxH], dims[kNchwDimIdxW], c0};
+  return CalcElementCntByDims(store_dims, sizeof(store_dims) / sizeof(store_dims[0]), element_cnt);
 }
 
 ///
 /// Calculate FractalZ element num.
 /// @param dims dim info
+/// @param dim_num dim num
 /// @param data_type data type
 /// @param element_cnt element count
 /// @return GRAPH_SUCCESS:success
 ///         other:failed
 ///
-static graphStatus CalcElementCntOfFractalZ(const std::vector<int64_t> &dims, DataType data_type,
+static graphStatus CalcElementCntOfFractalZ(const int64_t *dims, size_t dim_num, DataType data_type,
                                             int64_t &element_cnt) {
   static char parser_priority[MMPA_MAX_PATH] = { 0x00 };
   INT32 res = mmGetEnv("PARSER_PRIORITY", parser_priority, MMPA_MAX_PATH);
-  if (res == EN_OK && string(parser_priority) == "cce") {
-    if (dims.size() != kDimSize4d) {
-      GELOGE(GRAPH_FAILED, "CalcElementCntOfFractalZ failed as dims.size=%zu is not %u.", dims.size(), kDimSize4d);
+  if (res == EN_OK && strcmp(parser_priority, "cce") == 0) {
+    if (dim_num != kDimSize4d) {
+      GELOGE(GRAPH_FAILED, "CalcElementCntOfFractalZ failed as dims.size=%zu is not %u.", dim_num, kDimSize4d);
       return GRAPH_FAILED;
     }
     auto c0 = static_cast<int64_t>(GetDimC0(data_type));
@@ -195,10 +205,11 @@ static graphStatus CalcElementCntOfFractalZ(const std::vector<int64_t> &dims, Da
 
     // Spread NC1HWC0 as a two dimension array, n as column dimension,
     // C1HWC0 as row dimension
-    std::vector<int64_t> r_count_vec = {c1, dims[kNchwDimIdxH], dims[kNchwDimIdxW], c0};
+    const int64_t r_count_dims[] = {c1, dims[kNchwDimIdxH], dims[kNchwDimIdxW], c0};
 
     int64_t r_count = 1;
-    graphStatus graph_status = CalcElementCntByDims(r_count_vec, r_count);
+    graphStatus graph_status =
+        CalcElementCntByDims(r_count_dims, sizeof(r_count_dims) / sizeof(r_count_dims[0]), r_count);
     if (graph_status != GRAPH_SUCCESS) {
       GELOGE(graph_status, "Calc [%ld, %ld, %ld, %ld] element count failed.",
              c1, dims[kNchwDimIdxH], dims[kNchwDimIdxW], c0);
@@ -228,119 +239,154 @@ static graphStatus CalcElementCntOfFractalZ(const std::vector<int64_t> &dims, Da
     element_cnt = c_cnt * cube_elem_cnt;
     return GRAPH_SUCCESS;
   } else {
-    return CalcElementCntByDims(dims, element_cnt);
+    return CalcElementCntByDims(dims, dim_num, element_cnt);
   }
 }
 
+namespace {
+enum ElementCntCalcType {
+  kCalcUnsupported = 0,
+  kCalcByDims,
+  kCalcFixedDims,
+  kCalcNc1hwc0,
+  kCalcFractalZ
+};
+
+struct ElementCntCalcInfo {
+  ElementCntCalcType calc_type;
+  // only used by kCalcFixedDims
+  uint32_t fixed_dim_size;
+};
+
+// How to calculate element count of each format, indexed by format
+class ElementCntCalcTable {
+ public:
+  ElementCntCalcTable() {
+    for (auto &info : infos_) {
+      info = {kCalcUnsupported, 0};
+    }
+    const Format by_dims_formats[] = {
+        FORMAT_ND, FORMAT_MD, FORMAT_FRACTAL_NZ, FORMAT_FRACTAL_ZZ, FORMAT_NDHWC, FORMAT_NCDHW, FORMAT_DHWCN,
+        FORMAT_DHWNC, FORMAT_FRACTAL_Z_3D, FORMAT_FRACTAL_Z_3D_TRANSPOSE, FORMAT_NDC1HWC0, FORMAT_FRACTAL_Z_C04,
+        FORMAT_FRACTAL_ZN_LSTM, FORMAT_NC1HWC0_C04};
+    for (auto format : by_dims_formats) {
+      infos_[format] = {kCalcByDims, 0};
+    }
+    const Format fixed_4d_formats[] = {FORMAT_NCHW, FORMAT_HWCN, FORMAT_NHWC, FORMAT_CHWN};
+    for (auto format : fixed_4d_formats) {
+      infos_[format] = {kCalcFixedDims, kDimSize4d};
+    }
+    infos_[FORMAT_C1HWNCoC0] = {kCalcFixedDims, kDimSizeC1hwncoc0};
+    infos_[FORMAT_NC1HWC0] = {kCalcNc1hwc0, 0};
+    infos_[FORMAT_FRACTAL_Z] = {kCalcFractalZ, 0};
+  }
+
+  const ElementCntCalcInfo &Get(Format format) const {
+    return (static_cast<size_t>(format) < FORMAT_RESERVED) ? infos_[format] : infos_[FORMAT_RESERVED];
+  }
+
+ private:
+  // the extra last one is the unsupported info for formats out of range
+  ElementCntCalcInfo infos_[FORMAT_RESERVED + 1];
+};
+
+const ElementCntCalcTable &GetElementCntCalcTable() {
+  static const ElementCntCalcTable table;
+  return table;
+}
+}  // namespace
+
 ///
 /// Calculate tensor element num.
 /// @param dims dim info
+/// @param dim_num dim num
 /// @param format tensor format
 /// @param data_type data type
 /// @param element_cnt element count
 /// @return GRAPH_SUCCESS:success
 ///         other:failed
 ///
-static graphStatus CalcTensorElementCnt(const std::vector<int64_t> &dims, Format format, DataType data_type,
+static graphStatus CalcTensorElementCnt(const int64_t *dims, size_t dim_num, Format format, DataType data_type,
                                         int64_t &element_cnt) {
-  const string format_str = TypeUtils::FormatToSerialString(format);
   // Check dims
-  for (size_t i = 0; i < dims.size(); ++i) {
+  for (size_t i = 0; i < dim_num; ++i) {
     int64_t dim = dims[i];
     if (dim < 0) {
-      GELOGI("It's unknown shape, as dims[%zu]=%ld negative, format=%d(%s).", i, dim, format, format_str.c_str());
+      GELOGI("It's unknown shape, as dims[%zu]=%ld negative, format=%d(%s).", i, dim, format,
+             TypeUtils::FormatToSerialString(format).c_str());
       element_cnt = kElementCntUnknownShape;
       return GRAPH_SUCCESS;
     } else if (dim == 0) {
-      GELOGI("No need calc element count, as dims[%zu]=%ld, format=%d(%s).", i, dim, format, format_str.c_str());
+      GELOGI("No need calc element count, as dims[%zu]=%ld, format=%d(%s).", i, dim, format,
+             TypeUtils::FormatToSerialString(format).c_str());
       element_cnt = 0;
       return GRAPH_SUCCESS;
     }
   }
 
   graphStatus graph_status;
-  switch (format) {
-    case FORMAT_ND:
-    case FORMAT_MD:
-      graph_status = CalcElementCntByDims(dims, element_cnt);
-      break;
-    case FORMAT_NCHW:
-    case FORMAT_HWCN:
-    case FORMAT_NHWC:
-    case FORMAT_CHWN:
-      graph_status = CalcElementCntOfFixedDims(dims, format, kDimSize4d, element_cnt);
-      break;
-    case FORMAT_C1HWNCoC0:
-      graph_status = CalcElementCntOfFixedDims(dims, format, kDimSizeC1hwncoc0, element_cnt);
+  const ElementCntCalcInfo &calc_info = GetElementCntCalcTable().Get(format);
+  switch (calc_info.calc_type) {
+    case kCalcByDims:
+      graph_status = CalcElementCntByDims(dims, dim_num, element_cnt);
       break;
-    case FORMAT_NC1HWC0:
-      graph_status = CalcElementCntOfNc1hwc0(dims, data_type, element_cnt);
+    case kCalcFixedDims:
+      graph_status = CalcElementCntOfFixedDims(dims, dim_num, format, calc_info.fixed_dim_size, element_cnt);
       break;
-    case FORMAT_FRACTAL_Z:
-      graph_status = CalcElementCntOfFractalZ(dims, data_type, element_cnt);
+    case kCalcNc1hwc0:
+      graph_status = CalcElementCntOfNc1hwc0(dims, dim_num, data_type, element_cnt);
       break;
-    case FORMAT_FRACTAL_NZ:
-    case FORMAT_FRACTAL_ZZ:
-    case FORMAT_NDHWC:
-    case FORMAT_NCDHW:
-    case FORMAT_DHWCN:
-    case FORMAT_DHWNC:
-    case FORMAT_FRACTAL_Z_3D:
-    case FORMAT_FRACTAL_Z_3D_TRANSPOSE:
-    case FORMAT_NDC1HWC0:
-    case FORMAT_FRACTAL_Z_C04:
-    case FORMAT_FRACTAL_ZN_LSTM:
-    case FORMAT_NC1HWC0_C04:
-      graph_status = CalcElementCntByDims(dims, element_cnt);
+    case kCalcFractalZ:
+      graph_status = CalcElementCntOfFractalZ(dims, dim_num, data_type, element_cnt);
       break;
     default:
       ErrorManager::GetInstance().ATCReportErrMessage("E19012", {"function", "reason"},
-          {"CalcTensorElementCnt", "format[" + format_str + "] is not support"});
-      GELOGE(GRAPH_FAILED, "unsupported format, format=%d(%s).", format, format_str.c_str());
+          {"CalcTensorElementCnt", "format[" + TypeUtils::FormatToSerialString(format) + "] is not support"});
+      GELOGE(GRAPH_FAILED, "unsupported format, format=%d(%s).", format,
+             TypeUtils::FormatToSerialString(format).c_str());
       graph_status = GRAPH_FAILED;
       break;
   }
 
-  const string type_str = TypeUtils::DataTypeToSerialString(data_type);
   if (graph_status == GRAPH_SUCCESS) {
     GELOGD(
         "CalcTensorElementCnt end, format=%d(%s),"
         " data_type=%d(%s), element_cnt=%ld.",
-        format, format_str.c_str(), data_type, type_str.c_str(), element_cnt);
+        format, TypeUtils::FormatToSerialString(format).c_str(), data_type,
+        TypeUtils::DataTypeToSerialString(data_type).c_str(), element_cnt);
   } else {
     GELOGE(GRAPH_FAILED, "CalcTensorElementCnt failed, format=%d(%s), data_type=%d(%s).",
-           format, format_str.c_str(), data_type, type_str.c_str());
+           format, TypeUtils::FormatToSerialString(format).c_str(), data_type,
+           TypeUtils::DataTypeToSerialString(data_type).c_str());
   }
   return graph_status;
 }
 
 ///
-/// Calculate tensor mem size.
-/// @param shape tensor shape
+/// Calculate tensor mem size by dims view.
+/// @param dims dim info, may be nullptr when dim_num is 0
+/// @param dim_num dim num
 /// @param format tensor format
 /// @param data_type tensor data type
 /// @param mem_size -1 means unknown shape,other means mem size
 /// @return GRAPH_SUCCESS:success, other:failed
 ///
-GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus TensorUtils::CalcTensorMemSize(const GeShape &shape,
-                                                                                          Format format,
-                                                                                          DataType data_type,
-                                                                                          int64_t &mem_size) {
-  const string format_str = TypeUtils::FormatToSerialString(format);
-  const string type_str = TypeUtils::DataTypeToSerialString(data_type);
+static graphStatus CalcTensorMemSizeByDims(const int64_t *dims, size_t dim_num, Format format, DataType data_type,
+                                           int64_t &mem_size) {
   uint32_t type_size = 0;
   bool result = TypeUtils::GetDataTypeLength(data_type, type_size);
   if (!result) {
-    GELOGE(GRAPH_FAILED, "GetDataTypeLength failed, data_type=%d(%s).", data_type, type_str.c_str());
+    GELOGE(GRAPH_FAILED, "GetDataTypeLength failed, data_type=%d(%s).", data_type,
+           TypeUtils::DataTypeToSerialString(data_type).c_str());
     return GRAPH_FAILED;
   }
 
-  std::vector<int64_t> dims = shape.GetDims();
   int64_t element_cnt = 0;
-  graphStatus status = CalcTensorElementCnt(dims, format, data_type, element_cnt);
+  graphStatus status = CalcTensorElementCnt(dims, dim_num, format, data_type, element_cnt);
   if (status != GRAPH_SUCCESS) {
     GELOGE(status, "CalcTensorElementCnt failed, status=%u format=%d(%s) data_type=%d(%s).",
-           status, format, format_str.c_str(), data_type, type_str.c_str());
+           status, format, TypeUtils::FormatToSerialString(format).c_str(), data_type,
+           TypeUtils::DataTypeToSerialString(data_type).c_str());
     return status;
   }
   // Support unknown shape
@@ -349,13 +395,15 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus TensorUtils::CalcTens
     GELOGD(
         "element_cnt is unknown. "
         "format=%d(%s), data_type=%d(%s), mem_size=%ld",
-        format, format_str.c_str(), data_type, type_str.c_str(), mem_size);
+        format, TypeUtils::FormatToSerialString(format).c_str(), data_type,
+        TypeUtils::DataTypeToSerialString(data_type).c_str(), mem_size);
     return GRAPH_SUCCESS;
   }
   auto type_size_int64 = static_cast<int64_t>(type_size);
   if (CheckMultiplyOverflowInt64(element_cnt, type_size_int64)) {
     GELOGE(GRAPH_FAILED, "CalcTensorMemSize overflow, when multiplying %ld and %ld, format=%d(%s), data_type=%d(%s).",
-           element_cnt, type_size_int64, format, format_str.c_str(), data_type, type_str.c_str());
+           element_cnt, type_size_int64, format, TypeUtils::FormatToSerialString(format).c_str(), data_type,
+           TypeUtils::DataTypeToSerialString(data_type).c_str());
     return GRAPH_FAILED;
   }
   mem_size = element_cnt * type_size_int64;
@@ -363,10 +411,32 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus TensorUtils::CalcTens
   GELOGD(
       "CalcTensorMemSize end, "
       "format=%d(%s), data_type=%d(%s), mem_size=%ld",
-      format, format_str.c_str(), data_type, type_str.c_str(), mem_size);
+      format, TypeUtils::FormatToSerialString(format).c_str(), data_type,
+      TypeUtils::DataTypeToSerialString(data_type).c_str(), mem_size);
   return GRAPH_SUCCESS;
 }
 
+///
+/// Calculate tensor mem size.
+/// @param shape tensor shape
+/// @param format tensor format
+/// @param data_type tensor data type
+/// @param mem_size -1 means unknown shape,other means mem size
+/// @return GRAPH_SUCCESS:success, other:failed
+///
+GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus TensorUtils::CalcTensorMemSize(const GeShape &shape,
+                                                                                          Format format,
+                                                                                          DataType data_type,
+                                                                                          int64_t &mem_size) {
+  // Read dims in place instead of copying them out by GetDims
+  auto proto_msg = shape.shape_def_.GetProtoMsg();
+  if (proto_msg == nullptr) {
+    return CalcTensorMemSizeByDims(nullptr, 0, format, data_type, mem_size);
+  }
+  return CalcTensorMemSizeByDims(proto_msg->dim().data(), static_cast<size_t>(proto_msg->dim_size()), format,
+                                 data_type, mem_size);
+}
+
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus
 TensorUtils::GetTensorMemorySizeInBytes(const GeTensorDesc &desc_temp, int64_t &size_temp) {
   graphStatus graph_status = GetTensorSizeInBytes(desc_temp, size_temp);
@@ -383,11 +453,19 @@ TensorUtils::GetTensorMemorySizeInBytes(const GeTensorDesc &desc_temp, int64_t &
 }
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus
 TensorUtils::GetTensorSizeInBytes(const GeTensorDesc &desc_temp, int64_t &size_temp) {
-  GeShape output_shape = desc_temp.GetShape();
   Format format = desc_temp.GetFormat();
   DataType data_type = desc_temp.GetDataType();
   int64_t output_mem_size = 0;
-  graphStatus graph_status = CalcTensorMemSize(output_shape, format, data_type, output_mem_size);
+  graphStatus graph_status = GRAPH_SUCCESS;
+  // Read dims from the tensor descriptor in place instead of copying the shape out
+  auto tensor_descriptor_msg = desc_temp.tensor_descriptor_.GetProtoMsg();
+  if (tensor_descriptor_msg == nullptr) {
+    graph_status = CalcTensorMemSizeByDims(nullptr, 0, format, data_type, output_mem_size);
+  } else {
+    const auto &dims = tensor_descriptor_msg->shape().dim();
+    graph_status = CalcTensorMemSizeByDims(dims.data(), static_cast<size_t>(dims.size()), format, data_type,
+                                           output_mem_size);
+  }
   if (graph_status != GRAPH_SUCCESS) {
     GELOGE(GRAPH_FAILED, "CalcTensorMemSize failed!");
     return GRAPH_FAILED;
@@ -402,4 +480,36 @@ TensorUtils::GetTensorSizeInBytes(const GeTensorDesc &desc_temp, int64_t &size_t
   size_temp = output_mem_size;
   return GRAPH_SUCCESS;
 }
+
+GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus
+TensorUtils::CalcGraphOutputMemSize(const ComputeGraph &graph, std::vector<int64_t> &mem_sizes) {
+  mem_sizes.clear();
+  auto all_nodes = graph.GetAllNodes();
+  mem_sizes.reserve(all_nodes.size());
+  for (const auto &node : all_nodes) {
+    GE_CHECK_NOTNULL(node);
+    auto op_desc = node->GetOpDesc();
+    GE_CHECK_NOTNULL(op_desc);
+    for (const auto &output_desc : op_desc->GetAllOutputsDescPtr()) {
+      GE_CHECK_NOTNULL(output_desc);
+      int64_t mem_size = 0;
+      auto tensor_descriptor_msg = output_desc->tensor_descriptor_.GetProtoMsg();
+      graphStatus graph_status = GRAPH_SUCCESS;
+      if (tensor_descriptor_msg == nullptr) {
+        graph_status = CalcTensorMemSizeByDims(nullptr, 0, output_desc->GetFormat(), output_desc->GetDataType(),
+                                               mem_size);
+      } else {
+        const auto &dims = tensor_descriptor_msg->shape().dim();
+        graph_status = CalcTensorMemSizeByDims(dims.data(), static_cast<size_t>(dims.size()),
+                                               output_desc->GetFormat(), output_desc->GetDataType(), mem_size);
+      }
+      if (graph_status != GRAPH_SUCCESS) {
+        GELOGE(GRAPH_FAILED, "Calc output mem size of node %s failed.", node->GetName().c_str());
+        return GRAPH_FAILED;
+      }
+      mem_sizes.push_back(mem_size);
+    }
+  }
+  return GRAPH_SUCCESS;
+}
 }  // namespace ge
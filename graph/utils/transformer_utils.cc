@@ -16,55 +16,84 @@
 
 #include "transformer_utils.h"
 
+#include <algorithm>
+
 #include "external/ge/ge_api_types.h"
 #include "framework/common/debug/ge_log.h"
 #include "graph/utils/type_utils.h"
 
 namespace ge {
+namespace {
+// ShapeTransferAccordingToFormat only reads its tables after construction, so one instance serves all tensors
+common::transformer::ShapeTransferAccordingToFormat &GetShapeTransfer() {
+  static common::transformer::ShapeTransferAccordingToFormat shape_transfer;
+  return shape_transfer;
+}
+
+GeShape TransferShape(const GeShape &shape, Format src_format, Format dst_format, DataType dtype) {
+  std::vector<int64_t> src_dims = shape.GetDims();
+  std::vector<int64_t> dst_dims;
+  common::transformer::ShapeAndFormat shape_and_format_info {src_dims, dst_dims, src_format, dst_format, dtype,
+                                                             common::transformer::EN_IMPL_CUSTOM_TBE};
+  GetShapeTransfer().GetShapeAccordingToFormat(shape_and_format_info);
+  return GeShape(dst_dims);
+}
+}  // namespace
+
+void NodeShapeTransUtils::TensorFormatRecords::Resize(size_t size) {
+  size_ = size;
+  for (auto &record : inline_records_) {
+    record = TensorFormatRecord();
+  }
+  extra_records_.assign((size > kInlineRecordNum) ? (size - kInlineRecordNum) : 0, TensorFormatRecord());
+}
+
 bool NodeShapeTransUtils::CatchFormatAndShape() {
-  auto inputs = op_desc_->MutableAllInputName();
-  auto outputs = op_desc_->MutableAllOutputName();
+  input_records_.Resize(op_desc_->GetAllInputsSize());
+  output_records_.Resize(op_desc_->GetOutputsSize());
 
-  for (auto &ele : inputs) {
-    auto tensor_desc_input = op_desc_->MutableInputDesc(ele.first);
+  for (size_t i = 0; i < input_records_.Size(); ++i) {
+    auto tensor_desc_input = op_desc_->MutableInputDesc(static_cast<uint32_t>(i));
     if (tensor_desc_input == nullptr) {
       continue;
     }
     auto format = tensor_desc_input->GetFormat();
     auto ori_format = tensor_desc_input->GetOriginFormat();
     if (format == ori_format) {
-      GELOGD("Node is %s, input tensor name is %s. ori format: %s, format: %s is same! No need to catch format&shape!",
-             op_desc_->GetName().c_str(), ele.first.c_str(), TypeUtils::FormatToSerialString(ori_format).c_str(),
+      GELOGD("Node is %s, input tensor index is %zu. ori format: %s, format: %s is same! "
+             "No need to catch format&shape!",
+             op_desc_->GetName().c_str(), i, TypeUtils::FormatToSerialString(ori_format).c_str(),
              TypeUtils::FormatToSerialString(format).c_str());
       continue;
     }
-    map_format_in_.insert(std::pair<std::string, Format>(ele.first, format));
-    map_ori_format_in_.insert(std::pair<std::string, Format>(ele.first, ori_format));
-    map_dtype_in_.insert(std::pair<std::string, DataType>(ele.first, tensor_desc_input->GetDataType()));
+    auto &record = input_records_[i];
+    record.caught = true;
+    record.format = format;
+    record.ori_format = ori_format;
+    record.dtype = tensor_desc_input->GetDataType();
     tensor_desc_input->SetFormat(ori_format);
     tensor_desc_input->SetShape(tensor_desc_input->GetOriginShape());
   }
 
-  for (auto &ele : outputs) {
-    auto tensor_desc_output = op_desc_->MutableOutputDesc(ele.first);
+  for (size_t i = 0; i < output_records_.Size(); ++i) {
+    auto tensor_desc_output = op_desc_->MutableOutputDesc(static_cast<uint32_t>(i));
     if (tensor_desc_output == nullptr) {
       continue;
     }
     auto format = tensor_desc_output->GetFormat();
     auto ori_format = tensor_desc_output->GetOriginFormat();
     if (format == ori_format) {
-      GELOGD("Node is %s, output tensor name is %s. ori format: %s, format: %s is same! No need to catch format&shape!",
-             op_desc_->GetName().c_str(), ele.first.c_str(), TypeUtils::FormatToSerialString(ori_format).c_str(),
+      GELOGD("Node is %s, output tensor index is %zu. ori format: %s, format: %s is same! "
+             "No need to catch format&shape!",
+             op_desc_->GetName().c_str(), i, TypeUtils::FormatToSerialString(ori_format).c_str(),
              TypeUtils::FormatToSerialString(format).c_str());
       continue;
     }
-    map_format_out_.insert(std::pair<std::string, Format>(ele.first, format));
-    map_ori_format_out_.insert(std::pair<std::string, Format>(ele.first, ori_format));
-    map_dtype_out_.insert(std::pair<std::string, DataType>(ele.first, tensor_desc_output->GetDataType()));
-
-    if (format == ori_format) {
-      continue;
-    }
+    auto &record = output_records_[i];
+    record.caught = true;
+    record.format = format;
+    record.ori_format = ori_format;
+    record.dtype = tensor_desc_output->GetDataType();
     tensor_desc_output->SetFormat(ori_format);
   }
 
@@ -72,92 +101,101 @@ bool NodeShapeTransUtils::CatchFormatAndShape() {
 }
 
 bool NodeShapeTransUtils::UpdateFormatAndShape() {
-  auto inputs = op_desc_->MutableAllInputName();
-  auto outputs = op_desc_->MutableAllOutputName();
+  size_t input_num = std::min(input_records_.Size(), op_desc_->GetAllInputsSize());
+  size_t output_num = std::min(output_records_.Size(), op_desc_->GetOutputsSize());
 
-  for (auto &ele : inputs) {
-    auto tensor_desc_input = op_desc_->MutableInputDesc(ele.first);
+  for (size_t i = 0; i < input_num; ++i) {
+    auto tensor_desc_input = op_desc_->MutableInputDesc(static_cast<uint32_t>(i));
     if (tensor_desc_input == nullptr) {
       continue;
     }
+    const auto &record = input_records_[i];
     // if can not find saved info, it says format and origin format is same when catched
-    if (map_format_in_.find(ele.first) == map_format_in_.end()) {
-      GELOGD("Node is [%s], input tensor name [%s] is not been catched.Skip update action for it!",
-             op_desc_->GetName().c_str(), ele.first.c_str());
+    if (!record.caught) {
+      GELOGD("Node is [%s], input tensor index [%zu] is not been catched.Skip update action for it!",
+             op_desc_->GetName().c_str(), i);
       tensor_desc_input->SetOriginFormat(tensor_desc_input->GetFormat());
       tensor_desc_input->SetOriginShape(tensor_desc_input->GetShape());
       continue;
     }
     auto ori_format = tensor_desc_input->GetFormat();
-    auto ori_shape = tensor_desc_input->GetShape();
-    auto curr_format = map_format_in_[ele.first];
+    auto curr_format = record.format;
     if (ori_format == curr_format) {
       continue;
     }
-    std::unique_ptr<common::transformer::ShapeTransferAccordingToFormat> shape_transfer(new(std::nothrow)
-      common::transformer::ShapeTransferAccordingToFormat());
-    if (shape_transfer == nullptr) {
-      GELOGE(GRAPH_FAILED, "Memory alloc failed");
-      return false;
-    }
-    std::vector<int64_t> ori_shape_dims = ori_shape.GetDims();
-    std::vector<int64_t> out_dims;
-    ge::DataType dtype =  map_dtype_in_[ele.first];
-    common::transformer::ShapeAndFormat shape_and_format_info {ori_shape_dims, out_dims, ori_format, curr_format, dtype,
-                                                               common::transformer::EN_IMPL_CUSTOM_TBE};
-    shape_transfer->GetShapeAccordingToFormat(shape_and_format_info);
+    tensor_desc_input->SetShape(TransferShape(tensor_desc_input->GetShape(), ori_format, curr_format, record.dtype));
     tensor_desc_input->SetFormat(curr_format);
-    tensor_desc_input->SetShape(GeShape(out_dims));
   }
 
-  for (auto &ele : outputs) {
-    auto tensor_desc_output = op_desc_->MutableOutputDesc(ele.first);
+  for (size_t i = 0; i < output_num; ++i) {
+    auto tensor_desc_output = op_desc_->MutableOutputDesc(static_cast<uint32_t>(i));
     if (tensor_desc_output == nullptr) {
       continue;
     }
+    const auto &record = output_records_[i];
     // if can not find saved info, it says format and origin format is same when catched
-    if (map_ori_format_out_.find(ele.first) == map_ori_format_out_.end()) {
-      GELOGD("Node is [%s], input tensor name [%s] is not been catched.Skip update action for it!",
-             op_desc_->GetName().c_str(), ele.first.c_str());
+    if (!record.caught) {
+      GELOGD("Node is [%s], output tensor index [%zu] is not been catched.Skip update action for it!",
+             op_desc_->GetName().c_str(), i);
       tensor_desc_output->SetOriginFormat(tensor_desc_output->GetFormat());
       tensor_desc_output->SetOriginShape(tensor_desc_output->GetShape());
       continue;
     }
     auto ori_shape = tensor_desc_output->GetShape();
     auto curr_format = tensor_desc_output->GetFormat();
-    if (curr_format != map_ori_format_out_[ele.first]) {
-      GELOGE(GRAPH_FAILED, "Node is %s, out tensor name is %s. format: %s, recorded origin format: %s is not same",
-             op_desc_->GetName().c_str(), ele.first.c_str(), TypeUtils::FormatToSerialString(curr_format).c_str(),
-             TypeUtils::FormatToSerialString(map_ori_format_out_[ele.first]).c_str());
-      return GRAPH_FAILED;
+    if (curr_format != record.ori_format) {
+      GELOGE(GRAPH_FAILED, "Node is %s, out tensor index is %zu. format: %s, recorded origin format: %s is not same",
+             op_desc_->GetName().c_str(), i, TypeUtils::FormatToSerialString(curr_format).c_str(),
+             TypeUtils::FormatToSerialString(record.ori_format).c_str());
+      return false;
     }
     tensor_desc_output->SetOriginShape(ori_shape);
-    auto saved_format = map_format_out_[ele.first];
+    auto saved_format = record.format;
     if (curr_format == saved_format) {
-      GELOGD("Nodeis %s, out tensor name is %s. ori format: %s, recorded format: %s is same! No need to transfer",
-             op_desc_->GetName().c_str(), ele.first.c_str(), TypeUtils::FormatToSerialString(curr_format).c_str(),
+      GELOGD("Nodeis %s, out tensor index is %zu. ori format: %s, recorded format: %s is same! No need to transfer",
+             op_desc_->GetName().c_str(), i, TypeUtils::FormatToSerialString(curr_format).c_str(),
              TypeUtils::FormatToSerialString(saved_format).c_str());
       continue;
     }
     tensor_desc_output->SetFormat(saved_format);
-    std::unique_ptr<common::transformer::ShapeTransferAccordingToFormat> shape_transfer(new(std::nothrow)
-      common::transformer::ShapeTransferAccordingToFormat());
-    if (shape_transfer == nullptr) {
-      GELOGE(GRAPH_FAILED, "Memory alloc failed");
-      return false;
-    }
-    std::vector<int64_t> ori_shape_dims = ori_shape.GetDims();
-    std::vector<int64_t> out_dims;
-    ge::DataType dtype =  tensor_desc_output->GetDataType();
-    common::transformer::ShapeAndFormat shape_and_format_info {ori_shape_dims, out_dims, curr_format, saved_format,
-                                                               dtype, common::transformer::EN_IMPL_CUSTOM_TBE};
-    shape_transfer->GetShapeAccordingToFormat(shape_and_format_info);
-    tensor_desc_output->SetShape(GeShape(out_dims));
-    GELOGD("Node is %s, out tensor name is %s. Update format and shape success，ori format: %s, format: %s",
-        op_desc_->GetName().c_str(), ele.first.c_str(), TypeUtils::FormatToSerialString(curr_format).c_str(),
+    tensor_desc_output->SetShape(TransferShape(ori_shape, curr_format, saved_format,
+                                               tensor_desc_output->GetDataType()));
+    GELOGD("Node is %s, out tensor index is %zu. Update format and shape success，ori format: %s, format: %s",
+        op_desc_->GetName().c_str(), i, TypeUtils::FormatToSerialString(curr_format).c_str(),
         TypeUtils::FormatToSerialString(saved_format).c_str());
   }
   GELOGD("Node is %s. Update format and shape success", op_desc_->GetName().c_str());
   return true;
 }
+
+bool NodeShapeTransUtils::CatchFormatAndShape(const ComputeGraphPtr &graph,
+                                              std::vector<NodeShapeTransUtils> &transformers) {
+  if (graph == nullptr) {
+    GELOGE(GRAPH_FAILED, "graph is nullptr");
+    return false;
+  }
+  transformers.clear();
+  auto all_nodes = graph->GetAllNodes();
+  transformers.reserve(all_nodes.size());
+  for (const auto &node : all_nodes) {
+    if ((node == nullptr) || (node->GetOpDesc() == nullptr)) {
+      continue;
+    }
+    transformers.emplace_back(node->GetOpDesc());
+    if (!transformers.back().CatchFormatAndShape()) {
+      GELOGE(GRAPH_FAILED, "Node %s catch format and shape info failed!", node->GetName().c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+bool NodeShapeTransUtils::UpdateFormatAndShape(std::vector<NodeShapeTransUtils> &transformers) {
+  for (auto &transformer : transformers) {
+    if (!transformer.UpdateFormatAndShape()) {
+      return false;
+    }
+  }
+  return true;
+}
 } // namespace ge
\ No newline at end of file
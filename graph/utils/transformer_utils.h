@@ -17,10 +17,12 @@
 
 #ifndef COMMON_GRAPH_UTILS_TRANSFORMER_UTILS_H_
 #define COMMON_GRAPH_UTILS_TRANSFORMER_UTILS_H_
+#include <array>
 #include <string>
-#include <map>
+#include <vector>
 
 #include "external/graph/types.h"
+#include "graph/compute_graph.h"
 #include "graph/op_desc.h"
 #include "graph/ge_tensor.h"
 #include "transformer/inc/transfer_shape_according_to_format.h"
@@ -31,19 +33,45 @@ class NodeShapeTransUtils {
   bool CatchFormatAndShape();
   bool UpdateFormatAndShape();
 
-  explicit NodeShapeTransUtils(OpDescPtr op_desc) : op_desc_(op_desc) {
-  }
+  ///
+  /// @brief Catch format and shape for all nodes of graph, including nodes of subgraphs
+  /// @param [in] graph
+  /// @param [out] transformers: one per node, pass to UpdateFormatAndShape after infershape
+  /// @return bool
+  ///
+  static bool CatchFormatAndShape(const ComputeGraphPtr &graph, std::vector<NodeShapeTransUtils> &transformers);
+  static bool UpdateFormatAndShape(std::vector<NodeShapeTransUtils> &transformers);
 
-  ~NodeShapeTransUtils() {
+  explicit NodeShapeTransUtils(OpDescPtr op_desc) : op_desc_(op_desc) {
   }
 
  private:
-  std::map<std::string, Format> map_format_in_;
-  std::map<std::string, Format> map_ori_format_in_;
-  std::map<std::string, DataType> map_dtype_in_;
-  std::map<std::string, Format> map_format_out_;
-  std::map<std::string, Format> map_ori_format_out_;
-  std::map<std::string, DataType> map_dtype_out_;
+  // format info of one tensor saved by CatchFormatAndShape, indexed by tensor position
+  struct TensorFormatRecord {
+    bool caught = false;
+    Format format = FORMAT_RESERVED;
+    Format ori_format = FORMAT_RESERVED;
+    DataType dtype = DT_UNDEFINED;
+  };
+
+  // most nodes have only a few tensors, records of those live inline and the rest spill to heap
+  class TensorFormatRecords {
+   public:
+    void Resize(size_t size);
+    size_t Size() const { return size_; }
+    TensorFormatRecord &operator[](size_t index) {
+      return (index < kInlineRecordNum) ? inline_records_[index] : extra_records_[index - kInlineRecordNum];
+    }
+
+   private:
+    static const size_t kInlineRecordNum = 8;
+    std::array<TensorFormatRecord, kInlineRecordNum> inline_records_;
+    std::vector<TensorFormatRecord> extra_records_;
+    size_t size_ = 0;
+  };
+
+  TensorFormatRecords input_records_;
+  TensorFormatRecords output_records_;
 
   OpDescPtr op_desc_;
 };
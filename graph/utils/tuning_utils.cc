@@ -18,6 +18,7 @@
 #include "../debug/ge_util.h"
 #include "../debug/ge_op_types.h"
 #include "framework/common/scope_guard.h"
+#include "utils/parallel_utils.h"
 
 namespace ge {
 namespace {
@@ -28,7 +29,11 @@ const std::string parent_node_attr = "parentNode";
 const std::string parent_node_anchor_index_attr = "_parentNodeAnchorIndex";
 const std::string tuning_subgraph_prefix = "/aicore_subgraph_";
 const std::string non_tuning_subgraph_prefix = "/subgraph_";
-const std::set<std::string> kPartitionOpTypes = {PLACEHOLDER, END};
+const OpTypeId kPlaceholderTypeId = OpTypeUtils::GetOpTypeId(PLACEHOLDER);
+const OpTypeId kEndTypeId = OpTypeUtils::GetOpTypeId(END);
+const OpTypeId kDataTypeId = OpTypeUtils::GetOpTypeId(DATA);
+const OpTypeId kNetOutputTypeId = OpTypeUtils::GetOpTypeId(NETOUTPUT);
+const std::set<OpTypeId> kPartitionOpTypes = {kPlaceholderTypeId, kEndTypeId};
 const std::set<std::string> kExeTypes = {DATA, NETOUTPUT};
 }
 NodeNametoNodeNameMap TuningUtils::data_2_netoutput_;
@@ -36,7 +41,6 @@ NodetoNodeNameMap TuningUtils::data_node_2_netoutput_ ;
 NodetoNodeMap TuningUtils::data_node_2_netoutput_node_;
 NodeVec TuningUtils::netoutput_nodes_;
 NodeVec TuningUtils::merged_graph_nodes_;
-SubgraphCreateOutNode TuningUtils::create_output_;
 std::mutex TuningUtils::mutex_;
 
 std::string TuningUtils::PrintCheckLog() {
@@ -69,29 +73,27 @@ std::string TuningUtils::GetNodeNameByAnchor(const Anchor *anchor) {
 graphStatus TuningUtils::ConvertGraphToFile(std::vector<ComputeGraphPtr> tuning_subgraphs,
                                             std::vector<ComputeGraphPtr> non_tuning_subgraphs,
                                             bool exe_flag, const std::string &path, const std::string &user_path) {
-  int64_t i = 0;
-  int64_t j = 0;
-  std::lock_guard<std::mutex> lock(mutex_);
-  for (auto &subgraph : tuning_subgraphs) {
-    create_output_.emplace(subgraph, nullptr);
-    auto help_info = HelpInfo{i, exe_flag, true, path, user_path};
-    if (MakeExeGraph(subgraph, help_info) != SUCCESS) {
-      GELOGE(GRAPH_FAILED, "TUU:subgraph %zu generate exe graph failed", i);
-      return GRAPH_FAILED;
+  // Each subgraph keeps its own state, so subgraphs are converted and dumped in parallel
+  auto convert_task = [&tuning_subgraphs, &non_tuning_subgraphs, exe_flag, &path, &user_path](size_t index) {
+    if (index < tuning_subgraphs.size()) {
+      auto help_info = HelpInfo{static_cast<int64_t>(index), exe_flag, true, path, user_path};
+      if (MakeExeGraph(tuning_subgraphs[index], help_info) != SUCCESS) {
+        GELOGE(GRAPH_FAILED, "TUU:subgraph %zu generate exe graph failed", index);
+        return false;
+      }
+      return true;
     }
-    i++;
-  }
-
-  for (auto &subgraph : non_tuning_subgraphs) {
-    create_output_.emplace(subgraph, nullptr);
-    auto help_info = HelpInfo{j, true, false, path, user_path};
-    if (MakeExeGraph(subgraph, help_info) != SUCCESS) {
-      GELOGE(GRAPH_FAILED, "TUU:non tuning_subgraph %zu generate exe graph failed", j);
-      return GRAPH_FAILED;
+    size_t non_tuning_index = index - tuning_subgraphs.size();
+    auto help_info = HelpInfo{static_cast<int64_t>(non_tuning_index), true, false, path, user_path};
+    if (MakeExeGraph(non_tuning_subgraphs[non_tuning_index], help_info) != SUCCESS) {
+      GELOGE(GRAPH_FAILED, "TUU:non tuning_subgraph %zu generate exe graph failed", non_tuning_index);
+      return false;
     }
-    j++;
+    return true;
+  };
+  if (!ParallelFor(tuning_subgraphs.size() + non_tuning_subgraphs.size(), 0, convert_task)) {
+    return GRAPH_FAILED;
   }
-  create_output_.clear();
   return SUCCESS;
 }
 
@@ -134,9 +136,10 @@ graphStatus TuningUtils::MakeExeGraph(ComputeGraphPtr &exe_graph,
     return SUCCESS;
   }
   // modify sub graph
+  NodePtr out_node = nullptr;
   for (NodePtr &node : exe_graph->GetDirectNode()) {
     // 1.handle pld
-    if (node->GetType() == PLACEHOLDER) {
+    if (node->GetTypeId() == kPlaceholderTypeId) {
       if (HandlePld(node) != SUCCESS) {
         GELOGE(FAILED, "TUU:Failed to handle node %s from graph %s", node->GetName().c_str(),
                exe_graph->GetName().c_str());
@@ -144,8 +147,8 @@ graphStatus TuningUtils::MakeExeGraph(ComputeGraphPtr &exe_graph,
       }
     }
     // 2.handle end
-    if (node->GetType() == END) {
-      if (HandleEnd(node) != SUCCESS) {
+    if (node->GetTypeId() == kEndTypeId) {
+      if (HandleEnd(node, out_node) != SUCCESS) {
         GELOGE(FAILED, "TUU:Failed to handle node %s from graph %s", node->GetName().c_str(),
                exe_graph->GetName().c_str());
         return FAILED;
@@ -330,16 +333,7 @@ graphStatus TuningUtils::CreateNetOutput(NodePtr &node, NodePtr &out_node) {
   GE_CHECK_NOTNULL(node);
   auto graph = node->GetOwnerComputeGraph();
   GE_CHECK_NOTNULL(graph);
-  auto search = create_output_.find(graph);
-  if (search == create_output_.end()) {
-    GELOGE(FAILED,
-           "TUU:node %s's owner sub graph %s not exist in create_output map",
-           node->GetName().c_str(),
-           graph->GetName().c_str());
-    return FAILED;
-  }
-  if (search->second != nullptr) {
-    out_node = search->second;
+  if (out_node != nullptr) {
     GELOGD("TUU:sub graph %s has created output node, just return", graph->GetName().c_str());
     return SUCCESS;
   }
@@ -351,7 +345,6 @@ graphStatus TuningUtils::CreateNetOutput(NodePtr &node, NodePtr &out_node) {
     GELOGE(FAILED, "TUU:SetOwnerComputeGraph failed");
     return FAILED;
   }
-  create_output_[graph] = out_node;
   return SUCCESS;
 }
 
@@ -450,11 +443,10 @@ graphStatus TuningUtils::ChangeEnd2NetOutput(NodePtr &end_node, NodePtr &out_nod
   return SUCCESS;
 }
 
-graphStatus TuningUtils::HandleEnd(NodePtr &node) {
+graphStatus TuningUtils::HandleEnd(NodePtr &node, NodePtr &out_node) {
   GE_CHECK_NOTNULL(node);
   auto graph = node->GetOwnerComputeGraph();
   GE_CHECK_NOTNULL(graph);
-  NodePtr out_node = nullptr;
 
   // 1. create net_output node , add only one NetOutput node to one subgraph
   if (CreateNetOutput(node, out_node) != SUCCESS) {
@@ -486,6 +478,8 @@ graphStatus TuningUtils::HandleEnd(NodePtr &node) {
 
 // part 2
 graphStatus TuningUtils::ConvertFileToGraph(const map<int64_t, string> &options, ge::Graph &graph) {
+  // the merge maps are shared by all callers
+  std::lock_guard<std::mutex> lock(mutex_);
   std::function<void()> callback = [&]() {
     data_2_netoutput_.clear();
     data_node_2_netoutput_.clear();
@@ -561,14 +555,22 @@ graphStatus TuningUtils::ConvertFileToGraph(const map<int64_t, string> &options,
 graphStatus TuningUtils::MergeAllSubGraph(std::vector<ComputeGraphPtr> &subgraphs,
                                           ComputeGraphPtr &output_merged_compute_graph) {
   GE_CHECK_NOTNULL(output_merged_compute_graph);
-  // 1. handle all subgraphs
+  // 1. handle all subgraphs, nodes are gathered into a local buffer and joined once
+  MergeInfo merge_info;
   for (auto &subgraph : subgraphs) {
-    Status ret_status = MergeSubGraph(subgraph);
+    GE_CHECK_NOTNULL(subgraph);
+    Status ret_status = MergeSubGraph(subgraph, merge_info);
     if (ret_status != SUCCESS) {
       GELOGE(ret_status, "TUU:subgraph %s merge failed", subgraph->GetName().c_str());
       return ret_status;
     }
   }
+  data_2_netoutput_.insert(merge_info.data_2_netoutput.begin(), merge_info.data_2_netoutput.end());
+  data_node_2_netoutput_.insert(merge_info.data_node_2_netoutput.begin(), merge_info.data_node_2_netoutput.end());
+  netoutput_nodes_.insert(netoutput_nodes_.end(), merge_info.netoutput_nodes.begin(),
+                          merge_info.netoutput_nodes.end());
+  merged_graph_nodes_.insert(merged_graph_nodes_.end(), merge_info.merged_graph_nodes.begin(),
+                             merge_info.merged_graph_nodes.end());
 
   for (const auto &node: merged_graph_nodes_) {
     (void) output_merged_compute_graph->AddNode(node);
@@ -590,42 +592,37 @@ graphStatus TuningUtils::MergeAllSubGraph(std::vector<ComputeGraphPtr> &subgraph
   return SUCCESS;
 }
 
-graphStatus TuningUtils::MergeSubGraph(ComputeGraphPtr &subgraph) {
+graphStatus TuningUtils::MergeSubGraph(ComputeGraphPtr &subgraph, MergeInfo &merge_info) {
   for (auto &node : subgraph->GetDirectNode()) {
-    if (kPartitionOpTypes.count(node->GetType()) > 0) {
+    if (kPartitionOpTypes.count(node->GetTypeId()) > 0) {
       GELOGE(FAILED, "TUU:subgraph passed in should not contain nodes of end or pld type");
       return FAILED;
     }
     // handle data converted from pld node
-    if (node->GetType() == DATA) {
+    if (node->GetTypeId() == kDataTypeId) {
       auto op_desc = node->GetOpDesc();
       GE_CHECK_NOTNULL(op_desc);
       std::string peer_out_name;
       bool has_valid_str =
           (AttrUtils::GetStr(op_desc, peer_node_name_attr, peer_out_name)) && (!peer_out_name.empty());
       if (has_valid_str) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        data_2_netoutput_.emplace(op_desc->GetName(), peer_out_name);
-        data_node_2_netoutput_.emplace(node, peer_out_name);
+        merge_info.data_2_netoutput.emplace(op_desc->GetName(), peer_out_name);
+        merge_info.data_node_2_netoutput.emplace(node, peer_out_name);
         continue;
       }
     }
     // handle netoutput converted from end node
-    if (node->GetType() == NETOUTPUT) {
+    if (node->GetTypeId() == kNetOutputTypeId) {
       auto op_desc = node->GetOpDesc();
       GE_CHECK_NOTNULL(op_desc);
       std::vector<string> out_alias_name;
       bool has_valid_str =
           (AttrUtils::GetListStr(op_desc, alias_name_attr, out_alias_name)) && (!out_alias_name.empty());
       if (has_valid_str) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        netoutput_nodes_.emplace_back(node);
+        merge_info.netoutput_nodes.emplace_back(node);
       }
     }
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      merged_graph_nodes_.emplace_back(node);
-    }
+    merge_info.merged_graph_nodes.emplace_back(node);
     GELOGD("TUU:subgraph %s add node %s success", subgraph->GetName().c_str(), node->GetName().c_str());
   }
   GELOGI("TUU:merge subgraph %s success", subgraph->GetName().c_str());
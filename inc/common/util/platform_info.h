@@ -40,6 +40,20 @@ class PlatformInfoManager {
 
   uint32_t GetPlatformInfoWithOutSocVersion(PlatformInfo &platform_info, OptionalInfo &opti_compilation_info);
 
+  // Look up the platform info of soc_version without copying it. The pointed-to info is owned by the manager,
+  // is never modified after InitializePlatformInfo and stays valid until Finalize. Returns 0 on success.
+  uint32_t GetPlatformInfoRef(const string &soc_version, const PlatformInfo *&platform_info) const {
+    if (!init_flag_) {
+      return 1;
+    }
+    auto iter = platform_info_map_.find(soc_version);
+    if (iter == platform_info_map_.end()) {
+      return 1;
+    }
+    platform_info = &iter->second;
+    return 0;
+  }
+
   void SetOptionalCompilationInfo(OptionalInfo &opti_compilation_info);
 
  private:
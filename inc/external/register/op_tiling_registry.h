@@ -90,6 +90,8 @@ class FMK_FUNC_HOST_VISIBILITY OpTilingRegistryInterf {
   OpTilingRegistryInterf(std::string op_type, OpTilingFunc func);
   ~OpTilingRegistryInterf() = default;
   static std::map<std::string, OpTilingFunc> &RegisteredOpInterf();
+  // Registered functions are copied into an immutable hash table on first lookup, registering drops it
+  static const OpTilingFunc *GetOpTilingFunc(const std::string &op_type);
 };
 
 template <class T>
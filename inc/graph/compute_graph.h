@@ -17,9 +17,11 @@
 #ifndef INC_GRAPH_COMPUTE_GRAPH_H_
 #define INC_GRAPH_COMPUTE_GRAPH_H_
 
+#include <iterator>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <deque>
@@ -72,8 +74,66 @@ class ComputeGraph : public std::enable_shared_from_this<ComputeGraph>, public A
   using AttrHolder::HasAttr;
   using AttrHolder::SetAttr;
 
+  /// Visits nodes in the same order as GetAllNodes without building a node vector, each node's
+  /// subgraphs follow the node. The graph and its subgraphs must not be modified while iterating.
+  class AllNodesIterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = NodePtr;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const NodePtr *;
+    using reference = const NodePtr &;
+
+    AllNodesIterator() = default;
+    reference operator*() const { return frames_.back().graph->nodes_[frames_.back().node_index]; }
+    pointer operator->() const { return &(operator*()); }
+    AllNodesIterator &operator++();
+    AllNodesIterator operator++(int) {
+      AllNodesIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    bool operator==(const AllNodesIterator &other) const {
+      if (frames_.empty() || other.frames_.empty()) {
+        return frames_.empty() && other.frames_.empty();
+      }
+      return (frames_.size() == other.frames_.size()) && (frames_.back().graph == other.frames_.back().graph) &&
+             (frames_.back().node_index == other.frames_.back().node_index);
+    }
+    bool operator!=(const AllNodesIterator &other) const { return !(*this == other); }
+
+   private:
+    friend class ComputeGraph;
+    // root owns all subgraphs, subgraph names are looked up there
+    AllNodesIterator(const ComputeGraph *root, const ComputeGraph *graph);
+    struct Frame {
+      const ComputeGraph *graph;
+      size_t node_index;
+      // next subgraph of the current node to visit
+      size_t subgraph_index;
+    };
+    const ComputeGraph *root_ = nullptr;
+    // one frame per nesting level, graphs without subgraphs never grow it past one
+    std::vector<Frame> frames_;
+  };
+
+  class AllNodesRange {
+   public:
+    AllNodesIterator begin() const { return AllNodesIterator(root_.get(), graph_.get()); }
+    AllNodesIterator end() const { return AllNodesIterator(); }
+
+   private:
+    friend class ComputeGraph;
+    AllNodesRange(std::shared_ptr<ConstComputeGraph> graph, std::shared_ptr<ConstComputeGraph> root)
+        : graph_(std::move(graph)), root_(std::move(root)) {}
+    std::shared_ptr<ConstComputeGraph> graph_;
+    std::shared_ptr<ConstComputeGraph> root_;
+  };
+
   size_t GetAllNodesSize() const;
   Vistor<NodePtr> GetAllNodes() const;
+  // Same nodes and order as GetAllNodes, visited lazily
+  AllNodesRange AllNodes() const;
   // is_unknown_shape: false, same with GetAllNodes func
   // is_unknown_shape: true, same with GetDirectNodes func
   Vistor<NodePtr> GetNodes(bool is_unknown_shape) const;
@@ -141,12 +201,30 @@ class ComputeGraph : public std::enable_shared_from_this<ComputeGraph>, public A
 
   void Swap(ComputeGraph &graph);
 
+  /// @brief Share all attrs of graph instead of copying them. Both graphs read the same attr map, and a graph
+  ///        changing attrs through AttrUtils or MutableAttrMap copies the map first while another graph holds it.
+  /// @param [in] graph
+  void ShareAttrsFrom(const ComputeGraph &graph);
+
   graphStatus IsolateNode(const NodePtr &node);
   graphStatus Verify();
   graphStatus InferShape();
   graphStatus InferOriginFormat();
   graphStatus InferShapeInNeed();
   graphStatus InsertEventNodes();
+
+  /// @brief Marked nodes are handled by InferShapeOfMarkedNodes and VerifyMarkedNodes, which only touch
+  ///        the marked nodes and their consumers instead of walking the whole graph.
+  ///        Marks are kept by the owner graph of the node and include subgraphs when called on the root graph.
+  /// @param [in] node
+  void MarkNodeNeedInfer(const NodePtr &node);
+  void MarkNodeNeedVerify(const NodePtr &node);
+
+  /// @brief Infer marked nodes in topological order, consumers of inferred nodes are marked to be verified.
+  ///        Marks of inferred nodes are cleared, if inference stops the nodes not inferred keep their marks.
+  /// @return graphStatus
+  graphStatus InferShapeOfMarkedNodes();
+  graphStatus VerifyMarkedNodes();
   bool operator==(const ComputeGraph &r_compute_graph) const;
 
   /*lint +e504*/
@@ -258,6 +336,7 @@ class ComputeGraph : public std::enable_shared_from_this<ComputeGraph>, public A
   graphStatus TopologicalSortingGraph(bool dfs_reverse = false);
   graphStatus SortNodes(std::vector<NodePtr> &stack, std::map<NodePtr, uint32_t> &mapInEdgeNum);
   Vistor<NodePtr> AllGraphNodes(std::vector<std::shared_ptr<ComputeGraph>> &subgraphs) const;
+  static const std::vector<std::string> *GetSubgraphNames(const Node *node);
   size_t GetInEdgeSize(const NodePtr &node);
   size_t GetOutEdgeSize(const NodePtr &node);
   graphStatus RemoveExtraOutEdge(const NodePtr &node);
@@ -267,6 +346,13 @@ class ComputeGraph : public std::enable_shared_from_this<ComputeGraph>, public A
                                  const std::vector<NodePtr> &l_node_ptr_vector) const;
 
   void SetNodesOwner();
+  std::vector<ComputeGraph *> GetGraphsWithSubgraphs();
+  static void AddMarkedNode(std::vector<NodePtr> &marked_nodes, std::unordered_set<NodePtr> &marked_node_set,
+                            const NodePtr &node);
+  static void RemoveMarkedNode(std::vector<NodePtr> &marked_nodes, std::unordered_set<NodePtr> &marked_node_set,
+                               const NodePtr &node);
+  bool IsMarkedNodeOwned(const NodePtr &node) const;
+  static graphStatus UpdatePeerInputDescs(const NodePtr &node, std::vector<NodePtr> *consumers);
 
   friend class ModelSerializeImp;
   friend class GraphDebugImp;
@@ -276,9 +362,16 @@ class ComputeGraph : public std::enable_shared_from_this<ComputeGraph>, public A
   std::string name_;
   uint32_t graph_id_ = 0;
   ProtoAttrMapHelper attrs_;
+  // one per attr map and held by every graph sharing attrs_, so its use count tells if attrs_ is shared
+  std::shared_ptr<char> attrs_ref_;
   std::vector<NodePtr> nodes_;
   std::map<OperatorImplPtr, NodePtr> all_nodes_infos_;
   std::vector<NodePtr> target_nodes_info_;
+  // marked nodes in mark order, the sets only dedup marks
+  std::vector<NodePtr> need_infer_nodes_;
+  std::unordered_set<NodePtr> need_infer_node_set_;
+  std::vector<NodePtr> need_verify_nodes_;
+  std::unordered_set<NodePtr> need_verify_node_set_;
 
   std::vector<NodePtr> input_nodes_;
   std::vector<std::string> inputs_order_;
@@ -62,6 +62,7 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeShape {
  private:
   GeIrProtoHelper<proto::ShapeDef> shape_def_;
   friend class GeTensorDesc;
+  friend class TensorUtils;
   // Create from proto obj
   GeShape(const ProtoMsgOwner &protoOnwer, proto::ShapeDef *protoMsg);
 
@@ -161,6 +162,7 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeTensor {
   ~GeTensor() = default;
 
   GeTensorDesc GetTensorDesc() const;
+  const GeTensorDesc &GetTensorDescRef() const;
   GeTensorDesc &MutableTensorDesc();
   void SetTensorDesc(const GeTensorDesc &tensorDesc);
 
@@ -173,6 +175,11 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeTensor {
 
   GeTensor Clone() const;
 
+  // Share value with copy on write. The mark is kept with the value, so every handle of it, plain copies included,
+  // copies the value before its first change while another handle still holds it. A Buffer got from MutableData
+  // before sharing still writes to the shared value. A tensor not owning its value, e.g. a value of attr, is cloned.
+  GeTensor ShareCopyOnWrite() const;
+
   // Share value
   GeTensor(const GeTensor &other);
   // Share value
@@ -187,7 +194,10 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeTensor {
   GeIrProtoHelper<proto::TensorDef> tensor_def_;
   // Reference from tensorDef_, do not direct use
   mutable GeTensorDesc __desc_;
+  // Copy-on-write mark of the value, shared by all handles of tensor_def_, null if the value is not owned
+  std::shared_ptr<std::atomic<bool>> copy_on_write_;
   GeTensorDesc &DescReference() const;
+  void CopyBeforeWrite(bool keep_data);
 };
 }  // namespace ge
 #endif  // INC_GRAPH_GE_TENSOR_H_
@@ -92,6 +92,9 @@ class Node : public std::enable_shared_from_this<Node> {
 
   std::string GetName() const;
   std::string GetType() const;
+  const std::string &GetNameRef() const;
+  const std::string &GetTypeRef() const;
+  OpTypeId GetTypeId() const;
 
   ComputeGraphPtr GetOwnerComputeGraph() const;
   graphStatus SetOwnerComputeGraph(const ComputeGraphPtr &graph);
@@ -26,6 +26,7 @@
 #include <vector>
 #include "detail/attributes_holder.h"
 #include "graph/range_vistor.h"
+#include "graph/utils/op_type_utils.h"
 
 #define DYNAMIN_INPUT_NAME(name, index) (((name)) + std::to_string((index)))
 #define DYNAMIN_OUTPUT_NAME(name, index) (((name)) + std::to_string((index)))
@@ -82,6 +83,16 @@ class OpDesc : public std::enable_shared_from_this<OpDesc>, public AttrHolder {
 
   void SetType(const string &type);
 
+  // Same as GetName and GetType without copy, the reference is valid until the name or type is changed
+  const string &GetNameRef() const;
+
+  const string &GetTypeRef() const;
+
+  // Interned id of the type, compare it with OpTypeUtils::GetOpTypeId instead of comparing strings
+  OpTypeId GetTypeId() const { return type_id_; }
+
+  bool IsType(OpTypeId type_id) const { return type_id_ == type_id; }
+
   graphStatus AddInputDesc(const GeTensorDesc &input_desc);
 
   graphStatus AddInputDesc(const string &name, const GeTensorDesc &input_desc);
@@ -297,8 +308,13 @@ class OpDesc : public std::enable_shared_from_this<OpDesc>, public AttrHolder {
   bool OpDescMembersAreEqual(const OpDesc &r_op_desc) const;
   bool OpDescAttrsAreEqual(const OpDesc &r_op_desc) const;
   bool OpDescGenTensorDescsAreEqual(const OpDesc &r_op_desc) const;
+  void ClearIdxNameCache();
+  static void AppendIdxNameCache(std::shared_ptr<vector<string>> &idx_name, uint32_t index, const string &name);
+  static std::shared_ptr<const vector<string>> GetIdxNameCache(const map<string, uint32_t> &name_idx,
+                                                               std::shared_ptr<vector<string>> &idx_name);
 
   GeIrProtoHelper<ge::proto::OpDef> op_def_;
+  OpTypeId type_id_ = OpTypeUtils::kEmptyOpTypeId;
   std::vector<std::string> subgraph_instance_names_;
 
   // subgraph names to index, for a `if` operator:
@@ -324,6 +340,10 @@ class OpDesc : public std::enable_shared_from_this<OpDesc>, public AttrHolder {
   vector<GeTensorDescPtr> outputs_desc_{};
   map<string, uint32_t> output_name_idx_{};
   vector<string> register_output_name_{};
+  // index to name caches of input_name_idx_ and output_name_idx_, nullptr after the maps are changed.
+  // Const getters may rebuild them concurrently, so a cache is never changed once published by std::atomic_store
+  mutable std::shared_ptr<vector<string>> input_idx_name_{};
+  mutable std::shared_ptr<vector<string>> output_idx_name_{};
   std::function<graphStatus(Operator &)> infer_func_ = nullptr;
   std::function<graphStatus(Operator &)> infer_format_func_ = nullptr;
   std::function<graphStatus(Operator &)> verifier_func_ = nullptr;
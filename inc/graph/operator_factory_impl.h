@@ -19,14 +19,40 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "graph/operator_factory.h"
 #include "register/infer_data_slice_registry.h"
 
 namespace ge {
+struct OpRegistryRecord {
+  OpCreator creator;
+  OpCreatorV2 creator_v2;
+  InferShapeFunc infer_shape_func;
+  InferFormatFunc infer_format_func;
+  VerifyFunc verify_func;
+  InferDataSliceFunc infer_data_slice_func;
+};
+using OpRegistryRecordMap = std::unordered_map<std::string, OpRegistryRecord>;
+
 class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY OperatorFactoryImpl {
  public:
+  /**
+   * Compile all registered functions into one immutable table keyed by op type, after which lookups
+   * do a single hash lookup without lock. Any later registration drops the frozen table.
+   */
+  static void Freeze();
+
+  static bool IsFrozen();
+
+  /**
+   * While op_types is not null, every op type passed to a Register* function is added to it under the registry
+   * lock, including types already registered. Used to learn what a plugin library registers while it is loaded.
+   */
+  static void SetRegisterRecorder(std::set<std::string> *op_types);
+
   static Operator CreateOperator(const std::string &operator_name, const std::string &operator_type);
 
   static graphStatus GetOpsTypeList(std::vector<std::string> &all_ops);
@@ -60,6 +86,9 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY OperatorFactoryImpl {
   static shared_ptr<std::map<string, InferFormatFunc>> operator_inferformat_funcs_;
   static shared_ptr<std::map<string, VerifyFunc>> operator_verify_funcs_;
   static shared_ptr<std::map<string, InferDataSliceFunc>> operator_infer_data_slice_funcs_;
+
+ private:
+  static std::shared_ptr<const OpRegistryRecord> GetFrozenRecord(const std::string &operator_type, bool &frozen);
 };
 }  // namespace ge
 
@@ -24,6 +24,13 @@
 #include <mutex>
 
 namespace ge {
+struct OpsProtoLibStat {
+  std::string path;
+  bool loaded = false;
+  uint64_t load_time_us = 0;
+  size_t op_num = 0;
+};
+
 class OpsProtoManager {
  public:
   static OpsProtoManager *Instance();
@@ -31,11 +38,36 @@ class OpsProtoManager {
   bool Initialize(const std::map<std::string, std::string> &options);
   void Finalize();
 
+  /**
+   * Load the libraries which provide the given op types. Only takes effect in lazy load mode,
+   * in which libraries are not loaded by Initialize.
+   */
+  bool LoadOpsProto(const std::vector<std::string> &op_types);
+  bool LoadAllOpsProto();
+
+  void GetLoadStats(std::vector<OpsProtoLibStat> &stats);
+
  private:
+  struct OpsProtoLib {
+    std::string path;
+    int64_t size = 0;
+    int64_t mtime = 0;
+    std::vector<std::string> op_types;
+    void *handle = nullptr;
+    bool loaded = false;
+    uint64_t load_time_us = 0;
+  };
+
   void LoadOpsProtoPluginSo(std::string &path);
+  void LoadLib(OpsProtoLib &lib, bool record_ops);
+  bool LoadManifest();
+  void SaveManifest() const;
 
   std::string pluginPath_;
-  std::vector<void *> handles_;
+  std::string manifest_path_;
+  bool lazy_load_ = false;
+  std::vector<OpsProtoLib> libs_;
+  std::map<std::string, size_t> op_lib_index_;
   bool is_init_ = false;
   std::mutex mutex_;
 };
@@ -66,6 +66,8 @@ class RefRelations {
 public:
   graphStatus LookUpRefRelations(const RefCell &key, std::unordered_set<RefCell, RefCellHash> &result);
   graphStatus BuildRefRelations(ge::ComputeGraph &root_graph);
+  // Relations are built on the first lookup of each function node instead of for the whole graph at once
+  graphStatus BuildRefRelationsLazily(ge::ComputeGraph &root_graph);
   graphStatus Clear();
 
   RefRelations();
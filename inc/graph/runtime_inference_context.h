@@ -17,6 +17,7 @@
 #ifndef INC_GRAPH_RUNTIME_INFERENCE_CONTEXT_H_
 #define INC_GRAPH_RUNTIME_INFERENCE_CONTEXT_H_
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -28,20 +29,47 @@
 namespace ge {
 class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY RuntimeInferenceContext {
  public:
+  // context_id is the decimal string of session id, kept for compatibility
   static graphStatus GetContext(const std::string &context_id, RuntimeInferenceContext **ctx);
   static graphStatus CreateContext(const std::string &context_id);
   static void DestroyContext(const std::string &context_id);
 
+  // lookup takes no lock while no context is being created or destroyed
+  static graphStatus GetContext(uint64_t session_id, RuntimeInferenceContext **ctx);
+  static graphStatus CreateContext(uint64_t session_id);
+  static void DestroyContext(uint64_t session_id);
+
+  RuntimeInferenceContext();
+  ~RuntimeInferenceContext();
+
   graphStatus SetTensor(int64_t node_id, int output_id, Tensor &&tensor);
   graphStatus GetTensor(int64_t node_id, int output_id, GeTensorPtr &tensor);
   graphStatus GetTensor(int64_t node_id, int output_id, Tensor &tensor);
 
  private:
-  std::map<int64_t, std::vector<Tensor>> tensors_;
-  std::map<int64_t, std::vector<GeTensorPtr>> ge_tensors_;
+  struct NodeOutputs {
+    std::vector<Tensor> tensors;
+    std::vector<GeTensorPtr> ge_tensors;
+  };
+  // outputs are replaced as a whole by std::atomic_store under mu, GetTensor reads them by std::atomic_load
+  struct NodeTensors {
+    std::mutex mu;
+    std::shared_ptr<const NodeOutputs> outputs;
+  };
+  struct NodeTensorsChunk;
+
+  NodeTensors *GetNodeTensors(int64_t node_id, bool create);
+
+  // tensors of node id in [0, kChunkNodeNum * kMaxChunkNum) are stored in lazily allocated chunks
+  // indexed by node id, the others fall back to node_tensors_
+  static const int64_t kChunkNodeNum = 256;
+  static const int64_t kMaxChunkNum = 4096;
+  std::atomic<NodeTensorsChunk *> chunks_[kMaxChunkNum];
+  std::map<int64_t, std::unique_ptr<NodeTensors>> node_tensors_;
   std::mutex mu_;
 
-  static std::map<std::string, std::unique_ptr<RuntimeInferenceContext>> contexts_;
+  static std::map<uint64_t, std::unique_ptr<RuntimeInferenceContext>> contexts_;
+  static std::atomic<uint64_t> contexts_version_;
   static std::mutex ctx_mu_;
 };
 } // namespace ge
@@ -96,7 +96,8 @@ class TuningUtils {
   static graphStatus MakeExeGraph(ComputeGraphPtr &exe_graph,
                                   const HelpInfo& help_info);
   static graphStatus HandlePld(NodePtr &node);
-  static graphStatus HandleEnd(NodePtr &node);
+  // `out_node` is the NetOutput node of the subgraph, created by the first end node if it is nullptr
+  static graphStatus HandleEnd(NodePtr &node, NodePtr &out_node);
   static graphStatus ChangePld2Data(NodePtr &node, NodePtr &data_node);
   static graphStatus ChangeEnd2NetOutput(NodePtr &node, NodePtr &out_node);
   static graphStatus LinkEnd2NetOutput(NodePtr &node, NodePtr &out_node);
@@ -107,11 +108,17 @@ class TuningUtils {
   static void DumpGraphToPath(ComputeGraphPtr &exe_graph, int64_t index,
                               bool is_tuning_graph, std::string path);
 
-  static SubgraphCreateOutNode create_output_;
   // part 2
+  // Nodes gathered from the subgraphs, joined into the maps below once all subgraphs are merged
+  struct MergeInfo {
+    NodeNametoNodeNameMap data_2_netoutput;
+    NodetoNodeNameMap data_node_2_netoutput;
+    NodeVec netoutput_nodes;
+    NodeVec merged_graph_nodes;
+  };
   static graphStatus MergeAllSubGraph(std::vector<ComputeGraphPtr> &graphs,
                                       ComputeGraphPtr &graph);
-  static graphStatus MergeSubGraph(ComputeGraphPtr &graph);
+  static graphStatus MergeSubGraph(ComputeGraphPtr &graph, MergeInfo &merge_info);
   // Deletes new data and output nodes added by call `MakeExeGraph()` func in part 1
   static graphStatus RemoveDataNetoutputEdge(ComputeGraphPtr &graph);
   static graphStatus GetInAndOutAnchorPair(NodePtr &data_node,
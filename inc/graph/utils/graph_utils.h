@@ -808,5 +808,118 @@ class PartialGraphBuilder : public ComputeGraphBuilder {
 
   std::vector<NodePtr> exist_nodes_;
 };
+
+class BulkGraphBuilder {
+ public:
+  explicit BulkGraphBuilder(std::string name) : name_(std::move(name)) {}
+  BulkGraphBuilder(const BulkGraphBuilder &) = delete;
+  BulkGraphBuilder &operator=(const BulkGraphBuilder &) = delete;
+  BulkGraphBuilder(const BulkGraphBuilder &&) = delete;
+  BulkGraphBuilder &operator=(const BulkGraphBuilder &&) = delete;
+  ~BulkGraphBuilder() = default;
+
+  ///
+  /// @brief Preallocate storage for nodes and edges
+  /// @param [in] node_num
+  /// @param [in] edge_num
+  /// @return BulkGraphBuilder
+  ///
+  BulkGraphBuilder &Reserve(size_t node_num, size_t edge_num);
+
+  ///
+  /// @brief Add node with anonymous input and output tensors, the op desc is created in Build
+  /// @param [in] name
+  /// @param [in] type
+  /// @param [in] input_num
+  /// @param [in] output_num
+  /// @return index of the node, used by edges and attrs
+  ///
+  uint32_t AddNode(const std::string &name, const std::string &type, uint32_t input_num, uint32_t output_num);
+
+  ///
+  /// @brief Add node with an existing op desc
+  /// @param [in] op_desc
+  /// @return index of the node, used by edges and attrs
+  ///
+  uint32_t AddNode(const OpDescPtr &op_desc);
+
+  ///
+  /// @brief Set attr of the node
+  /// @param [in] node_index
+  /// @param [in] attr_name
+  /// @param [in] attr_value
+  /// @return BulkGraphBuilder
+  ///
+  BulkGraphBuilder &SetAttr(uint32_t node_index, const std::string &attr_name, const GeAttrValue &attr_value);
+
+  ///
+  /// @brief Add data-edge by node index and anchor index
+  /// @param [in] src_node
+  /// @param [in] out_anchor_ind
+  /// @param [in] dst_node
+  /// @param [in] in_anchor_ind
+  /// @return BulkGraphBuilder
+  ///
+  BulkGraphBuilder &AddDataEdge(uint32_t src_node, uint32_t out_anchor_ind, uint32_t dst_node,
+                                uint32_t in_anchor_ind);
+
+  ///
+  /// @brief Add ctrl-edge by node index
+  /// @param [in] src_node
+  /// @param [in] dst_node
+  /// @return BulkGraphBuilder
+  ///
+  BulkGraphBuilder &AddControlEdge(uint32_t src_node, uint32_t dst_node);
+
+  ///
+  /// @brief Build graph
+  /// @param [out] error_code
+  /// @param [out] error_msg
+  /// @param [in] thread_num: threads used to create op descs, 0 means decided by hardware concurrency
+  /// @return ComputeGraphPtr
+  ///
+  ComputeGraphPtr Build(graphStatus &error_code, std::string &error_msg, uint32_t thread_num = 1);
+
+  ///
+  /// @brief Get node by index after build
+  /// @param [in] node_index
+  /// @return NodePtr
+  ///
+  NodePtr GetNode(uint32_t node_index) const;
+
+ private:
+  struct NodeDef {
+    std::string name;
+    std::string type;
+    uint32_t input_num;
+    uint32_t output_num;
+    OpDescPtr op_desc;
+  };
+
+  struct EdgeDef {
+    uint32_t src_node;
+    uint32_t src_index;
+    uint32_t dst_node;
+    uint32_t dst_index;
+  };
+
+  ///
+  /// @brief Create op descs of nodes in [begin, end)
+  /// @param [in] begin
+  /// @param [in] end
+  /// @return graphStatus
+  ///
+  graphStatus CreateOpDescs(size_t begin, size_t end);
+
+  void BuildEdges(graphStatus &error_code, std::string &error_msg);
+
+  std::string name_;
+  std::vector<NodeDef> node_defs_;
+  std::vector<std::vector<std::pair<std::string, GeAttrValue>>> node_attrs_;
+  std::vector<EdgeDef> data_edges_;
+  std::vector<std::pair<uint32_t, uint32_t>> ctrl_edges_;
+  std::vector<NodePtr> nodes_;
+  bool has_null_op_desc_ = false;
+};
 }  // namespace ge
 #endif  // INC_GRAPH_UTILS_GRAPH_UTILS_H_
@@ -79,6 +79,13 @@ class OpDescUtils {
   static Operator CreateOperatorFromOpDesc(OpDescPtr op_desc);
   static Operator CreateOperatorFromNode(ge::ConstNodePtr node_ptr);
   static OpDescPtr GetOpDescFromOperator(const Operator& oprt);
+  // Tensor descs held by the operator, infer functions read and update them in place without the TensorDesc
+  // conversion of Operator::GetInputDesc/UpdateOutputDesc. Updating an output in place does not propagate it to
+  // linked inputs of other operators as Operator::UpdateOutputDesc does.
+  static GeTensorDescPtr MutableInputDesc(const Operator& oprt, const std::string& name);
+  static GeTensorDescPtr MutableInputDesc(const Operator& oprt, uint32_t index);
+  static GeTensorDescPtr MutableOutputDesc(const Operator& oprt, const std::string& name);
+  static GeTensorDescPtr MutableOutputDesc(const Operator& oprt, uint32_t index);
 
   static OpDescPtr CreateConstOp(const GeTensorPtr& tensor_ptr);
 
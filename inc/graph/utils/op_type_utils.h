@@ -0,0 +1,41 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INC_GRAPH_UTILS_OP_TYPE_UTILS_H_
+#define INC_GRAPH_UTILS_OP_TYPE_UTILS_H_
+
+#include <cstdint>
+#include <string>
+
+namespace ge {
+// Process-wide id of an interned op type, equal ids mean equal type strings
+using OpTypeId = uint32_t;
+
+class OpTypeUtils {
+ public:
+  // id of the empty type, which is also the type of a default constructed OpDesc
+  static const OpTypeId kEmptyOpTypeId = 0;
+
+  ///
+  /// @brief Intern the op type, the same type always gets the same id in the process.
+  ///        Looking up a type that is already interned takes no lock, only a new type does.
+  /// @param [in] type
+  /// @return OpTypeId
+  ///
+  static OpTypeId GetOpTypeId(const std::string &type);
+};
+}  // namespace ge
+#endif  // INC_GRAPH_UTILS_OP_TYPE_UTILS_H_
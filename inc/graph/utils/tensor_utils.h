@@ -23,6 +23,8 @@
 #include "graph/ge_tensor.h"
 
 namespace ge {
+class ComputeGraph;
+
 class TensorUtils {
  public:
   static ge::graphStatus GetSize(const GeTensorDesc &tensorDesc, int64_t &size);
@@ -72,6 +74,14 @@ class TensorUtils {
   static ge::graphStatus CalcTensorMemSize(const GeShape &shape, Format format, DataType data_type, int64_t &mem_size);
   static ge::graphStatus GetTensorMemorySizeInBytes(const GeTensorDesc &desc_temp, int64_t &size_temp);
   static ge::graphStatus GetTensorSizeInBytes(const GeTensorDesc &desc_temp, int64_t &size_temp);
+
+  ///
+  /// calculate mem size of all outputs of all nodes in graph and its subgraphs in a single pass.
+  /// @param graph compute graph
+  /// @param mem_sizes mem size of each output in order of nodes and output index, -1 means unknown shape
+  /// @return GRAPH_SUCCESS:success, other:failed
+  ///
+  static ge::graphStatus CalcGraphOutputMemSize(const ComputeGraph &graph, std::vector<int64_t> &mem_sizes);
 };
 }  // namespace ge
 #endif  // INC_GRAPH_UTILS_TENSOR_UTILS_H_
@@ -36,8 +36,13 @@ class FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY OpKernelRegistry {
 
   void RegisterHostCpuOp(const std::string &op_type, CreateFn create_fn);
 
+  void RegisterHostCpuOp(const std::string &op_type, CreateFn create_fn, bool stateless);
+
   std::unique_ptr<HostCpuOp> CreateHostCpuOp(const std::string &op_type);
 
+  // Returns the shared instance for stateless ops, and a new instance owned by the caller for other ops
+  std::shared_ptr<HostCpuOp> AcquireHostCpuOp(const std::string &op_type);
+
  private:
   OpKernelRegistry();
   class OpKernelRegistryImpl;
@@ -17,6 +17,7 @@
 #ifndef INC_REGISTER_OP_TILING_H_
 #define INC_REGISTER_OP_TILING_H_
 
+#include <memory>
 #include "graph/debug/ge_attr_define.h"
 #include "graph/node.h"
 #include "register/op_tiling_registry.h"
@@ -40,7 +41,67 @@ class FMK_FUNC_HOST_VISIBILITY OpTilingInterf {
   static std::string OpTilingUuid;
 };
 
+struct CompileInfoCacheStats {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t evictions = 0;
+  size_t size = 0;
+  size_t capacity = 0;
+};
+
+// Parsed OpCompileInfo::str, cached process wide by OpCompileInfo::key so nodes sharing the key parse it once.
+// OpParaCalculate and OpAtomicCalculate look the key up before reading the compile_info_json attr, on a hit the
+// cached OpCompileInfo is passed to the tiling function as is. Called by that tiling function with the
+// OpCompileInfo it was given, this returns the json parsed before the call without any lookup. Other callers are
+// looked up by key, and the key is assumed to identify the json.
+// Returns nullptr if key is empty or str is not valid json. The least recently used key is evicted when the cache
+// holds more keys than its capacity, 4096 by default.
+FMK_FUNC_HOST_VISIBILITY std::shared_ptr<const nlohmann::json> GetParsedCompileInfo(
+    const OpCompileInfo &op_compile_info);
+FMK_FUNC_HOST_VISIBILITY void SetCompileInfoCacheCapacity(size_t capacity);
+FMK_FUNC_HOST_VISIBILITY CompileInfoCacheStats GetCompileInfoCacheStats();
+
+// Binary tensor description for TbeOpTilingBinInterface, format/ori_format/dtype use the same strings as the
+// json interface, e.g. "NCHW" and "float16". A tensor is const when const_name is not null, its value is copied
+// from const_data.
+struct TeOpTensorBinDesc {
+  const int64_t *shape;
+  const int64_t *ori_shape;
+  const char *format;
+  const char *ori_format;
+  const char *dtype;
+  const char *const_name;
+  const void *const_data;
+  uint64_t const_data_len;
+  uint32_t shape_dims;
+  uint32_t ori_shape_dims;
+};
+
+struct TeOpTensorArgBinDesc {
+  TensorArgType arg_type;
+  uint32_t tensor_num;
+  const TeOpTensorBinDesc *tensors;
+};
+
+// Caller owned buffers for the tiling result. workspace_num and tiling_data_len are set to the sizes needed
+// even if the buffers are too small, so the caller can retry with larger buffers.
+struct TeOpRunInfoBinBuf {
+  uint32_t block_dim;
+  uint32_t clear_atomic;
+  int64_t *workspaces;
+  uint32_t workspace_cap;
+  uint32_t workspace_num;
+  uint8_t *tiling_data;
+  uint64_t tiling_data_cap;
+  uint64_t tiling_data_len;
+};
+
 extern "C" ge::graphStatus OpParaCalculate(const ge::Node &node, OpRunInfo &run_info);
+// Tiling of node_num nodes, result of nodes[i] is written to run_infos[i] as OpParaCalculate does.
+// Nodes are tiled one by one in the calling thread if thread_num is 0 or 1. A larger thread_num tiles them on up to
+// thread_num threads, so it may only be passed when the tiling functions of all the op types are thread safe.
+extern "C" ge::graphStatus OpParaCalculateBatch(const ge::Node *const *nodes, size_t node_num, OpRunInfo *run_infos,
+                                                uint32_t thread_num);
 extern "C" ge::graphStatus OpAtomicCalculate(const ge::Node &node, OpRunInfo &run_info);
 
 }  // namespace optiling
@@ -34,6 +34,8 @@ class FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY HostCpuOp {
 class FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY HostCpuOpRegistrar {
  public:
   HostCpuOpRegistrar(const char *op_type, HostCpuOp *(*create_fn)());
+  // stateless ops keep no state between Compute calls, one instance is created and shared by all callers
+  HostCpuOpRegistrar(const char *op_type, HostCpuOp *(*create_fn)(), bool stateless);
   ~HostCpuOpRegistrar() = default;
 };
 
@@ -49,6 +51,19 @@ class FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY HostCpuOpRegistrar {
           ::ge::HostCpuOpRegistrar(name, []()->::ge::HostCpuOp* {   \
             return new (std::nothrow) op();                           \
           })
+
+#define REGISTER_HOST_CPU_OP_BUILDER_STATELESS(name, op) \
+    REGISTER_HOST_CPU_OP_BUILDER_STATELESS_UNIQ_HELPER(__COUNTER__, name, op)
+
+#define REGISTER_HOST_CPU_OP_BUILDER_STATELESS_UNIQ_HELPER(ctr, name, op) \
+    REGISTER_HOST_CPU_OP_BUILDER_STATELESS_UNIQ(ctr, name, op)
+
+#define REGISTER_HOST_CPU_OP_BUILDER_STATELESS_UNIQ(ctr, name, op)    \
+  static ::ge::HostCpuOpRegistrar register_host_cpu_op##ctr           \
+      __attribute__((unused)) =                                       \
+          ::ge::HostCpuOpRegistrar(name, []()->::ge::HostCpuOp* {   \
+            return new (std::nothrow) op();                           \
+          }, true)
 } // namespace ge
 
 #endif //INC_REGISTER_REGISTRY_H_
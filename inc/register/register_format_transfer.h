@@ -45,6 +45,25 @@ struct TransResult {
   size_t length;
 };
 
+// Same as TransArgs, but shapes are borrowed from the caller instead of owned
+struct TransArgsView {
+  const uint8_t *data;
+  Format src_format;
+  Format dst_format;
+  const int64_t *src_shape;
+  size_t src_dim_num;
+  const int64_t *dst_shape;
+  size_t dst_dim_num;
+  DataType src_data_type;
+};
+
+// Destination memory owned by the caller, e.g. pooled or mmapped
+struct TransBuffer {
+  uint8_t *data;
+  // buffer length in bytes
+  size_t length;
+};
+
 class FormatTransfer {
  public:
   virtual ~FormatTransfer() = default;
@@ -53,6 +72,26 @@ class FormatTransfer {
                             Format dst_format, std::vector<int64_t> &dst_shape) = 0;
 };
 
+/// Optional interface of a transfer whose output can be split into independent tiles. A transfer opts in by
+/// deriving from both classes, TransFormatToBuffer finds it with dynamic_cast so FormatTransfer keeps its layout
+class TiledFormatTransfer {
+ public:
+  virtual ~TiledFormatTransfer() = default;
+
+  /// Number of independent output tiles, 0 means the transfer can not be split for 'args'
+  /// @param args
+  /// @return
+  virtual size_t GetTileNum(const TransArgsView &args) = 0;
+
+  /// Transfer the tile 'tile_index' into the whole output buffer 'dst', which is checked to hold the
+  /// dst shape of src data type. Tiles write disjoint parts of 'dst', so different tiles may run on different threads
+  /// @param args
+  /// @param tile_index
+  /// @param dst
+  /// @return
+  virtual Status TransFormatTile(const TransArgsView &args, size_t tile_index, TransBuffer &dst) = 0;
+};
+
 using FormatTransferBuilder = std::function<std::shared_ptr<FormatTransfer>()>;
 
 class FormatTransferRegister {
@@ -68,12 +107,21 @@ class FormatTransferRegister {
   }
 
 /// Build a formattransfer according to 'args'
+/// The registry is frozen into a dense table of builders on first lookup, each call still builds a new transfer
 /// @param args
 /// @param result
 /// @return
 std::shared_ptr<FormatTransfer> BuildFormatTransfer(const TransArgs &args);
 
 bool FormatTransferExists(const TransArgs &args);
+
+/// Transfer format into the buffer supplied by caller, tiles of a TiledFormatTransfer run in parallel,
+/// other transfers run TransFormat and copy the result
+/// @param args
+/// @param dst
+/// @param thread_num: 0 means decided by hardware concurrency
+/// @return
+Status TransFormatToBuffer(const TransArgsView &args, TransBuffer &dst, uint32_t thread_num = 0);
 }  // namespace formats
 }  // namespace ge
 #endif  // INC_REGISTER_REGISTER_FORMAT_TRANSFER_H_
\ No newline at end of file
@@ -17,6 +17,8 @@
 #ifndef TENSOR_ASSIGN_H_
 #define TENSOR_ASSIGN_H_
 
+#include <algorithm>
+#include <vector>
 #include "graph/ge_tensor.h"
 #include "proto/tensorflow/tensor.pb.h"
 
@@ -31,6 +33,17 @@ class TensorAssign {
  public:
   static Status SetGeTensor(const TensorProto &tensor, GeTensorPtr &weight);
 
+  /**
+   * @ingroup domi
+   * @brief decode a batch of const tensors, each tensor is decoded into the weight of the same index
+   * @param [in] tensors tensorflow const values, all elements must not be null
+   * @param [in|out] weights created weights, size must equal to tensors
+   * @param [in] thread_num max decode thread num, 0 means decided by hardware concurrency
+   * @return SUCCESS if all tensors are decoded, otherwise FAILED
+   */
+  static Status SetGeTensors(const std::vector<const TensorProto *> &tensors, std::vector<GeTensorPtr> &weights,
+                             uint32_t thread_num = 0);
+
   static Status SetGeTensorDataType(int64_t dataType, GeTensorPtr &weight);
 
   static ge::DataType ConvertTensorflowDataType(uint32_t tf_data_type);
@@ -75,24 +88,23 @@ class TensorAssign {
   static void SetWeightData(tensorflow::DataType data_type, int count, const std::string &tensor_content,
                             GeTensorPtr &weight);
 
+  static bool GetValSize(const TensorProto &tensor, int32_t &val_size);
+
   template <typename T>
   static Status GetVal(int32_t val_size, const google::protobuf::RepeatedField<T> &val_vector, int count,
                        GeTensorPtr &weight) {
     bool zerosLike = (count != val_size && val_size == 1);
     T *addr = new (std::nothrow) T[count]();
     GE_CHECK_NOTNULL(addr);
+    const T *src = val_vector.data();
     int minCount = (count > val_size) ? val_size : count;
     if (!zerosLike) {
-      for (int32_t i = 0; i < minCount; i++) {
-        *(addr + i) = val_vector.Get(i);
-      }
-      for (int32_t i = minCount; i < count; i++) {
-        *(addr + i) = val_vector.Get(minCount - 1);
+      std::copy(src, src + minCount, addr);
+      if (minCount > 0) {
+        std::fill(addr + minCount, addr + count, src[minCount - 1]);
       }
     } else {
-      for (int32_t i = 0; i < count; i++) {
-        *(addr + i) = val_vector.Get(0);
-      }
+      std::fill(addr, addr + count, src[0]);
     }
     (void)weight->SetData(reinterpret_cast<uint8_t *>(addr), count * sizeof(T));
     GE_DELETE_NEW_ARRAY(addr);
@@ -1,29 +1,80 @@
 #include "register/op_kernel_registry.h"
-#include <mutex>
 #include <map>
+#include <set>
+#include <unordered_map>
 #include "graph/debug/ge_log.h"
+#include "graph/utils/frozen_registry.h"
 
 namespace ge {
 class OpKernelRegistry::OpKernelRegistryImpl {
  public:
-  void RegisterHostCpuOp(const std::string &op_type, OpKernelRegistry::CreateFn create_fn) {
-    std::lock_guard<std::mutex> lock(mu_);
-    create_fns_[op_type] = create_fn;
+  struct CreateFnEntry {
+    OpKernelRegistry::CreateFn create_fn;
+    bool stateless;
+  };
+  struct FrozenEntry {
+    OpKernelRegistry::CreateFn create_fn;
+    std::shared_ptr<HostCpuOp> shared_op;
+  };
+  using FrozenCreateFnMap = std::unordered_map<std::string, FrozenEntry>;
+
+  void RegisterHostCpuOp(const std::string &op_type, OpKernelRegistry::CreateFn create_fn, bool stateless) {
+    frozen_.Update([this, &op_type, create_fn, stateless]() {
+      create_fns_[op_type] = CreateFnEntry{create_fn, stateless};
+      (void)changed_types_.insert(op_type);
+      return true;
+    });
   }
 
-  OpKernelRegistry::CreateFn GetCreateFn(const std::string &op_type) {
-    std::lock_guard<std::mutex> lock(mu_);
-    auto it = create_fns_.find(op_type);
-    if (it == create_fns_.end()) {
+  // Lookups run on the execution hot path, they read a frozen table without the lock once it is built
+  std::shared_ptr<const FrozenEntry> GetEntry(const std::string &op_type) {
+    auto frozen = frozen_.GetOrFreeze([this](const FrozenCreateFnMap *last, FrozenCreateFnMap &table) {
+      return Freeze(last, table);
+    });
+    if (frozen == nullptr) {
+      GELOGE(MEMALLOC_FAILED, "Failed to create frozen host cpu op registry.");
       return nullptr;
     }
-
-    return it->second;
+    auto it = frozen->find(op_type);
+    if (it == frozen->end()) {
+      return nullptr;
+    }
+    // the entry keeps the table alive while the caller uses it
+    return std::shared_ptr<const FrozenEntry>(frozen, &it->second);
   }
 
  private:
-  std::mutex mu_;
-  std::map<std::string, OpKernelRegistry::CreateFn> create_fns_;
+  // Runs under the registry lock. Entries of the last table are reused, so shared ops are only created for
+  // op types registered since then
+  bool Freeze(const FrozenCreateFnMap *last, FrozenCreateFnMap &table) {
+    table.reserve(create_fns_.size());
+    for (const auto &item : create_fns_) {
+      if ((last != nullptr) && (changed_types_.count(item.first) == 0)) {
+        auto last_it = last->find(item.first);
+        if (last_it != last->end()) {
+          (void)table.emplace(item.first, last_it->second);
+          continue;
+        }
+      }
+      FrozenEntry entry{item.second.create_fn, nullptr};
+      if (item.second.stateless && (item.second.create_fn != nullptr)) {
+        entry.shared_op.reset(item.second.create_fn());
+        if (entry.shared_op == nullptr) {
+          GELOGW("Failed to create shared host cpu op %s, fall back to create it per call", item.first.c_str());
+        }
+      }
+      (void)table.emplace(item.first, entry);
+    }
+    GELOGI("Freeze host cpu op registry, registered count:%zu, changed count:%zu", table.size(),
+           changed_types_.size());
+    changed_types_.clear();
+    return true;
+  }
+
+  std::map<std::string, CreateFnEntry> create_fns_;
+  // op types registered since the last freeze
+  std::set<std::string> changed_types_;
+  FrozenRegistry<FrozenCreateFnMap> frozen_;
 };
 
 OpKernelRegistry::OpKernelRegistry() {
@@ -40,16 +91,21 @@ bool OpKernelRegistry::IsRegistered(const std::string &op_type) {
     return false;
   }
 
-  return impl_->GetCreateFn(op_type) != nullptr;
+  auto entry = impl_->GetEntry(op_type);
+  return (entry != nullptr) && (entry->create_fn != nullptr);
 }
 
 void OpKernelRegistry::RegisterHostCpuOp(const std::string &op_type, CreateFn create_fn) {
+  RegisterHostCpuOp(op_type, create_fn, false);
+}
+
+void OpKernelRegistry::RegisterHostCpuOp(const std::string &op_type, CreateFn create_fn, bool stateless) {
   if (impl_ == nullptr) {
     GELOGE(MEMALLOC_FAILED, "Failed to register %s, OpKernelRegistry is not properly initialized", op_type.c_str());
     return;
   }
 
-  impl_->RegisterHostCpuOp(op_type, create_fn);
+  impl_->RegisterHostCpuOp(op_type, create_fn, stateless);
 }
 std::unique_ptr<HostCpuOp> OpKernelRegistry::CreateHostCpuOp(const std::string &op_type) {
   if (impl_ == nullptr) {
@@ -58,13 +114,32 @@ std::unique_ptr<HostCpuOp> OpKernelRegistry::CreateHostCpuOp(const std::string &
     return nullptr;
   }
 
-  auto create_fn = impl_->GetCreateFn(op_type);
-  if (create_fn == nullptr) {
+  auto entry = impl_->GetEntry(op_type);
+  if ((entry == nullptr) || (entry->create_fn == nullptr)) {
+    GELOGD("Host Cpu op is not registered. op type = %s", op_type.c_str());
+    return nullptr;
+  }
+
+  return std::unique_ptr<HostCpuOp>(entry->create_fn());
+}
+
+std::shared_ptr<HostCpuOp> OpKernelRegistry::AcquireHostCpuOp(const std::string &op_type) {
+  if (impl_ == nullptr) {
+    GELOGE(MEMALLOC_FAILED, "Failed to acquire op for %s, OpKernelRegistry is not properly initialized",
+           op_type.c_str());
+    return nullptr;
+  }
+
+  auto entry = impl_->GetEntry(op_type);
+  if ((entry == nullptr) || (entry->create_fn == nullptr)) {
     GELOGD("Host Cpu op is not registered. op type = %s", op_type.c_str());
     return nullptr;
   }
+  if (entry->shared_op != nullptr) {
+    return entry->shared_op;
+  }
 
-  return std::unique_ptr<HostCpuOp>(create_fn());
+  return std::shared_ptr<HostCpuOp>(entry->create_fn());
 }
 
 HostCpuOpRegistrar::HostCpuOpRegistrar(const char *op_type, HostCpuOp *(*create_fn)()) {
@@ -75,4 +150,13 @@ HostCpuOpRegistrar::HostCpuOpRegistrar(const char *op_type, HostCpuOp *(*create_
 
   OpKernelRegistry::GetInstance().RegisterHostCpuOp(op_type, create_fn);
 }
+
+HostCpuOpRegistrar::HostCpuOpRegistrar(const char *op_type, HostCpuOp *(*create_fn)(), bool stateless) {
+  if (op_type == nullptr) {
+    GELOGE(PARAM_INVALID, "Failed to register host cpu op, op type is null");
+    return;
+  }
+
+  OpKernelRegistry::GetInstance().RegisterHostCpuOp(op_type, create_fn, stateless);
+}
 } // namespace ge
\ No newline at end of file
@@ -19,11 +19,15 @@
 #include <chrono>
 #include <cstring>
 #include <algorithm>
+#include <list>
+#include <mutex>
+#include <unordered_map>
 #include "securec.h"
 #include "framework/common/debug/ge_log.h"
 #include "graph/debug/ge_log.h"
 #include "graph/debug/ge_util.h"
 #include "graph/utils/op_desc_utils.h"
+#include "graph/utils/parallel_utils.h"
 #include "graph/utils/type_utils.h"
 #include "graph/utils/tensor_utils.h"
 
@@ -56,6 +60,14 @@ const std::map<ge::DataType, std::string> DATATYPE_STRING_MAP{{ge::DT_FLOAT, "fl
                                                               {ge::DT_DUAL_SUB_INT8, "dual_sub_int8"},
                                                               {ge::DT_DUAL_SUB_UINT8, "dual_sub_uint8"}};
 
+const OpTilingFunc *FindOpTilingFunc(const std::string &op_type) {
+  const OpTilingFunc *tiling_func = OpTilingRegistryInterf::GetOpTilingFunc(op_type);
+  if (tiling_func == nullptr) {
+    tiling_func = OpTilingRegistryInterf::GetOpTilingFunc("AutoTiling");
+  }
+  return tiling_func;
+}
+
 bool FeedTeOpTensorArg(ge::OpDesc::Vistor<ge::GeTensorDescPtr> &tensor_desc, std::vector<TeOpTensorArg> &tensor_arg) {
   for (auto &desc : tensor_desc) {
     TeOpTensorArg arg_tensor;
@@ -118,20 +130,181 @@ void FeedTeOpConstTensor(const ge::Node &node, const ge::OpDescPtr &op_desc,
   }
 }
 
-bool GetCompileInfo(const ge::OpDescPtr &op_desc, const char *op_type, const char *op_name,
-                    OpCompileInfo &op_compile_info) {
+namespace {
+struct CompileInfoEntry {
+  OpCompileInfo info;
+  nlohmann::json parsed;
+  bool is_json;
+};
+using CompileInfoEntryPtr = std::shared_ptr<const CompileInfoEntry>;
+
+CompileInfoEntryPtr NewCompileInfoEntry(OpCompileInfo &&op_compile_info, bool need_parse) {
+  std::shared_ptr<CompileInfoEntry> entry(new (std::nothrow) CompileInfoEntry());
+  if (entry == nullptr) {
+    GE_LOGE("Failed to create compile info entry, key:%s", op_compile_info.key.c_str());
+    return nullptr;
+  }
+  entry->info = std::move(op_compile_info);
+  entry->is_json = false;
+  if (need_parse) {
+    entry->parsed = nlohmann::json::parse(entry->info.str, nullptr, false);
+    entry->is_json = !entry->parsed.is_discarded();
+  }
+  return entry;
+}
+
+std::shared_ptr<const nlohmann::json> ToParsed(const CompileInfoEntryPtr &entry) {
+  return ((entry != nullptr) && entry->is_json) ? std::shared_ptr<const nlohmann::json>(entry, &entry->parsed)
+                                                : nullptr;
+}
+
+// Compile info keyed by compile_info_key, the key identifies the compile info json so nodes sharing it share one
+// parsed entry. Entries are immutable, an entry handed out stays valid after it is evicted.
+class CompileInfoCache {
+ public:
+  static CompileInfoCache &Instance() {
+    static CompileInfoCache instance;
+    return instance;
+  }
+
+  CompileInfoEntryPtr Find(const std::string &key);
+  // parse and cache the compile info, returns the entry cached first if other threads add the same key
+  CompileInfoEntryPtr Add(OpCompileInfo &&op_compile_info);
+  void SetCapacity(size_t capacity);
+  CompileInfoCacheStats GetStats() const;
+
+ private:
+  using LruList = std::list<std::string>;
+
+  CompileInfoCache() = default;
+  ~CompileInfoCache() = default;
+  void EvictToCapacity(size_t capacity);
+
+  mutable std::mutex mutex_;
+  size_t capacity_ = 4096;
+  LruList lru_keys_;
+  std::unordered_map<std::string, std::pair<CompileInfoEntryPtr, LruList::iterator>> entries_;
+  CompileInfoCacheStats stats_;
+};
+
+CompileInfoEntryPtr CompileInfoCache::Find(const std::string &key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = entries_.find(key);
+  if (iter == entries_.end()) {
+    stats_.misses++;
+    return nullptr;
+  }
+  stats_.hits++;
+  lru_keys_.splice(lru_keys_.begin(), lru_keys_, iter->second.second);
+  return iter->second.first;
+}
+
+CompileInfoEntryPtr CompileInfoCache::Add(OpCompileInfo &&op_compile_info) {
+  // parse out of the lock, a key raced by other threads is parsed more than once and the first one is kept
+  CompileInfoEntryPtr entry = NewCompileInfoEntry(std::move(op_compile_info), true);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  const std::string &key = entry->info.key;
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = entries_.find(key);
+  if (iter != entries_.end()) {
+    return iter->second.first;
+  }
+  if (capacity_ > 0) {
+    EvictToCapacity(capacity_ - 1);
+    lru_keys_.push_front(key);
+    entries_.emplace(key, std::make_pair(entry, lru_keys_.begin()));
+  }
+  return entry;
+}
+
+void CompileInfoCache::EvictToCapacity(size_t capacity) {
+  while (!lru_keys_.empty() && (entries_.size() > capacity)) {
+    entries_.erase(lru_keys_.back());
+    lru_keys_.pop_back();
+    stats_.evictions++;
+  }
+}
+
+void CompileInfoCache::SetCapacity(size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = capacity;
+  EvictToCapacity(capacity_);
+}
+
+CompileInfoCacheStats CompileInfoCache::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  CompileInfoCacheStats stats = stats_;
+  stats.size = entries_.size();
+  stats.capacity = capacity_;
+  return stats;
+}
+
+// Entry of the compile info passed to the tiling function running on this thread, see GetParsedCompileInfo
+thread_local const CompileInfoEntryPtr *running_compile_info = nullptr;
+
+class RunningCompileInfoGuard {
+ public:
+  explicit RunningCompileInfoGuard(const CompileInfoEntryPtr &entry) : last_(running_compile_info) {
+    running_compile_info = &entry;
+  }
+  ~RunningCompileInfoGuard() { running_compile_info = last_; }
+
+ private:
+  const CompileInfoEntryPtr *last_;
+};
+}  // namespace
+
+std::shared_ptr<const nlohmann::json> GetParsedCompileInfo(const OpCompileInfo &op_compile_info) {
+  // compile info of OpParaCalculate and OpAtomicCalculate is parsed before the tiling function is called
+  if ((running_compile_info != nullptr) && (&(*running_compile_info)->info == &op_compile_info)) {
+    return ToParsed(*running_compile_info);
+  }
+  // without a key the parsed result could not be reused, leave the parsing to the tiling function
+  if (op_compile_info.key.empty()) {
+    return nullptr;
+  }
+  CompileInfoEntryPtr entry = CompileInfoCache::Instance().Find(op_compile_info.key);
+  if (entry == nullptr) {
+    OpCompileInfo compile_info_copy = op_compile_info;
+    entry = CompileInfoCache::Instance().Add(std::move(compile_info_copy));
+  }
+  return ToParsed(entry);
+}
+
+void SetCompileInfoCacheCapacity(size_t capacity) {
+  CompileInfoCache::Instance().SetCapacity(capacity);
+}
+
+CompileInfoCacheStats GetCompileInfoCacheStats() {
+  return CompileInfoCache::Instance().GetStats();
+}
+
+CompileInfoEntryPtr GetCompileInfo(const ge::OpDescPtr &op_desc, const char *op_type, const char *op_name) {
+  OpCompileInfo op_compile_info;
   bool bres = ge::AttrUtils::GetStr(op_desc, COMPILE_INFO_KEY, op_compile_info.key);
   if (!bres) {
     GE_LOGE("Can not find the attribute %s. op_type:%s, op_name:%s", COMPILE_INFO_KEY, op_type, op_name);
-    return false;
+    return nullptr;
+  }
+  // the key identifies the json, on a hit neither copy nor parse the json attr again
+  if (!op_compile_info.key.empty()) {
+    CompileInfoEntryPtr entry = CompileInfoCache::Instance().Find(op_compile_info.key);
+    if (entry != nullptr) {
+      return entry;
+    }
   }
 
   bres = ge::AttrUtils::GetStr(op_desc, COMPILE_INFO_JSON, op_compile_info.str);
   if (!bres) {
     GE_LOGE("Can not find the attribute %s. op_type:%s, op_name:%s", COMPILE_INFO_JSON, op_type, op_name);
-    return false;
+    return nullptr;
   }
-  return true;
+  if (op_compile_info.key.empty()) {
+    return NewCompileInfoEntry(std::move(op_compile_info), false);
+  }
+  return CompileInfoCache::Instance().Add(std::move(op_compile_info));
 }
 
 void ParseShapeDesc(const nlohmann::json &shape, std::vector<TeOpTensor> &tensors) {
@@ -208,6 +381,15 @@ bool CopyConstData(const std::string &dtype, const nlohmann::json &json_array, s
   return true;
 }
 
+ge::TensorDesc MakeConstTensorDesc(const std::vector<int64_t> &shape, std::string format_str, std::string dtype_str) {
+  std::transform(dtype_str.begin(), dtype_str.end(), dtype_str.begin(), ::toupper);
+  dtype_str = "DT_" + dtype_str;
+  ge::DataType ge_dtype = ge::TypeUtils::SerialStringToDataType(dtype_str);
+  std::transform(format_str.begin(), format_str.end(), format_str.begin(), ::toupper);
+  ge::Format ge_format = ge::TypeUtils::SerialStringToFormat(format_str);
+  return ge::TensorDesc(ge::Shape(shape), ge_format, ge_dtype);
+}
+
 void ParseConstShapeDesc(const nlohmann::json &shape_json, std::map<std::string, TeConstTensorData> &const_tensors,
                          std::map<std::string, std::vector<uint8_t>> &const_values) {
   std::vector<int64_t> shape;
@@ -245,13 +427,7 @@ void ParseConstShapeDesc(const nlohmann::json &shape_json, std::map<std::string,
     return;  // CodeDEX complains 'CHECK_CONTAINER_EMPTY'
   }
 
-  ge::Shape ge_shape(shape);
-  std::transform(dtype_str.begin(), dtype_str.end(), dtype_str.begin(), ::toupper);
-  dtype_str = "DT_" + dtype_str;
-  ge::DataType ge_dtype = ge::TypeUtils::SerialStringToDataType(dtype_str);
-  std::transform(format_str.begin(), format_str.end(), format_str.begin(), ::toupper);
-  ge::Format ge_format = ge::TypeUtils::SerialStringToFormat(format_str);
-  ge::Tensor const_tensor(ge::TensorDesc(ge_shape, ge_format, ge_dtype), res.first->second);
+  ge::Tensor const_tensor(MakeConstTensorDesc(shape, format_str, dtype_str), res.first->second);
   const_tensors.emplace(name, std::make_tuple(const_tensor.GetData(), const_tensor.GetSize(), const_tensor));
   return;
 }
@@ -329,21 +505,16 @@ extern "C" int TbeOpTilingPyInterfaceEx2(const char *optype, const char *compile
     return 0;
   }
 
-  auto &interf = OpTilingRegistryInterf::RegisteredOpInterf();
-  auto iter = interf.find(optype);
-  if (iter == interf.end()) {
-    iter = interf.find("AutoTiling");
-  }
-
-  if (iter == interf.end()) {
+  const OpTilingFunc *tiling_func = FindOpTilingFunc(optype);
+  if (tiling_func == nullptr) {
     GE_LOGE("Optiling func not found. op_type:%s", optype);
     return 0;
   }
 
-  GELOGI("Optiling func found, op_type:%s, func:[%s:%p]", optype, iter->first.c_str(),
-         iter->second.target<OpTilingFuncPtr>());
+  GELOGI("Optiling func found, op_type:%s, func:[%p]", optype, tiling_func->target<OpTilingFuncPtr>());
 
-  OpCompileInfo op_compile_info{compile_info};
+  OpCompileInfo op_compile_info;
+  op_compile_info.str = compile_info;
   if (compile_info_hash) {
     op_compile_info.key = compile_info_hash;
   }
@@ -353,7 +524,7 @@ extern "C" int TbeOpTilingPyInterfaceEx2(const char *optype, const char *compile
     before_tiling = std::chrono::steady_clock::now();
   }
 
-  bool rc = (iter->second)(op_params, op_compile_info, run_info);
+  bool rc = (*tiling_func)(op_params, op_compile_info, run_info);
 
   if (elapse) {
     after_tiling = std::chrono::steady_clock::now();
@@ -374,6 +545,152 @@ extern "C" int TbeOpTilingPyInterfaceEx2(const char *optype, const char *compile
   return 1;
 }
 
+bool ParseBinTensorArgs(const TeOpTensorArgBinDesc *args, uint32_t arg_num, std::vector<TeOpTensorArg> &op_args,
+                        std::map<std::string, TeConstTensorData> *const_tensors) {
+  if ((arg_num > 0) && (args == nullptr)) {
+    GE_LOGE("tensor args is null, arg num %u", arg_num);
+    return false;
+  }
+  op_args.resize(arg_num);
+  for (uint32_t i = 0; i < arg_num; ++i) {
+    const TeOpTensorArgBinDesc &arg = args[i];
+    if ((arg.tensor_num > 0) && (arg.tensors == nullptr)) {
+      GE_LOGE("tensors of arg %u is null", i);
+      return false;
+    }
+    TeOpTensorArg &tensor_arg = op_args[i];
+    tensor_arg.arg_type = arg.arg_type;
+    tensor_arg.tensor.resize(arg.tensor_num);
+    for (uint32_t j = 0; j < arg.tensor_num; ++j) {
+      const TeOpTensorBinDesc &desc = arg.tensors[j];
+      TeOpTensor &tensor = tensor_arg.tensor[j];
+      if (desc.shape != nullptr) {
+        tensor.shape.assign(desc.shape, desc.shape + desc.shape_dims);
+      }
+      if (desc.ori_shape != nullptr) {
+        tensor.ori_shape.assign(desc.ori_shape, desc.ori_shape + desc.ori_shape_dims);
+      }
+      if (desc.format != nullptr) {
+        tensor.format = desc.format;
+      }
+      if (desc.ori_format != nullptr) {
+        tensor.ori_format = desc.ori_format;
+      }
+      if (desc.dtype != nullptr) {
+        tensor.dtype = desc.dtype;
+      }
+      if ((const_tensors == nullptr) || (desc.const_name == nullptr)) {
+        continue;
+      }
+      if ((desc.const_data == nullptr) && (desc.const_data_len > 0)) {
+        GE_LOGE("const data of %s is null", desc.const_name);
+        return false;
+      }
+      // tiling functions read the value either from the pointer or from the tensor, so the tensor holds it too
+      ge::Tensor const_tensor(MakeConstTensorDesc(tensor.shape, tensor.format, tensor.dtype));
+      if ((desc.const_data_len > 0) &&
+          (const_tensor.SetData(static_cast<const uint8_t *>(desc.const_data),
+                                static_cast<size_t>(desc.const_data_len)) != ge::GRAPH_SUCCESS)) {
+        GE_LOGE("Failed to set const data of %s, size %lu", desc.const_name, desc.const_data_len);
+        return false;
+      }
+      const_tensors->emplace(desc.const_name,
+                             std::make_tuple(const_tensor.GetData(), const_tensor.GetSize(), const_tensor));
+    }
+  }
+  return true;
+}
+
+bool DumpRunInfoBin(OpRunInfo &run_info, TeOpRunInfoBinBuf &run_info_buf) {
+  run_info_buf.block_dim = run_info.block_dim;
+  run_info_buf.clear_atomic = run_info.clear_atomic ? 1 : 0;
+
+  size_t workspace_num = run_info.workspaces.size();
+  run_info_buf.workspace_num = static_cast<uint32_t>(workspace_num);
+  if (workspace_num > run_info_buf.workspace_cap) {
+    GE_LOGE("workspaces too many. %zu/%u", workspace_num, run_info_buf.workspace_cap);
+    return false;
+  }
+  if ((workspace_num > 0) && (run_info_buf.workspaces == nullptr)) {
+    GE_LOGE("workspaces buffer is null");
+    return false;
+  }
+  std::copy(run_info.workspaces.begin(), run_info.workspaces.end(), run_info_buf.workspaces);
+
+  auto tiling_data_len = static_cast<uint64_t>(run_info.tiling_data.tellp());
+  run_info_buf.tiling_data_len = tiling_data_len;
+  if (tiling_data_len > run_info_buf.tiling_data_cap) {
+    GE_LOGE("tiling data too large. %lu/%lu", tiling_data_len, run_info_buf.tiling_data_cap);
+    return false;
+  }
+  if ((tiling_data_len > 0) && (run_info_buf.tiling_data == nullptr)) {
+    GE_LOGE("tiling data buffer is null");
+    return false;
+  }
+  run_info.tiling_data.seekg(0);
+  size_t nread = ByteBufferGetAll(run_info.tiling_data, reinterpret_cast<char *>(run_info_buf.tiling_data),
+                                  static_cast<size_t>(tiling_data_len));
+  return nread == tiling_data_len;
+}
+
+extern "C" int TbeOpTilingBinInterface(const char *optype, const char *compile_info, const char *compile_info_hash,
+                                       const TeOpTensorArgBinDesc *inputs, uint32_t input_num,
+                                       const TeOpTensorArgBinDesc *outputs, uint32_t output_num,
+                                       TeOpRunInfoBinBuf *run_info_buf, uint64_t *elapse) {
+  if (optype == nullptr || compile_info == nullptr || run_info_buf == nullptr) {
+    GE_LOGE("optype/compile_info/run_info_buf is null");
+    return 0;
+  }
+
+  std::chrono::time_point<std::chrono::steady_clock> before_tiling, after_tiling;
+
+  TeOpParas op_params;
+  op_params.op_type = optype;
+  if (!ParseBinTensorArgs(inputs, input_num, op_params.inputs, &op_params.const_inputs) ||
+      !ParseBinTensorArgs(outputs, output_num, op_params.outputs, nullptr)) {
+    GE_LOGE("Failed to parse tensor desc. op_type:%s", optype);
+    return 0;
+  }
+
+  const OpTilingFunc *tiling_func = FindOpTilingFunc(optype);
+  if (tiling_func == nullptr) {
+    GE_LOGE("Optiling func not found. op_type:%s", optype);
+    return 0;
+  }
+
+  GELOGI("Optiling func found, op_type:%s, func:[%p]", optype, tiling_func->target<OpTilingFuncPtr>());
+
+  OpCompileInfo op_compile_info;
+  op_compile_info.str = compile_info;
+  if (compile_info_hash) {
+    op_compile_info.key = compile_info_hash;
+  }
+
+  OpRunInfo run_info;
+  if (elapse) {
+    before_tiling = std::chrono::steady_clock::now();
+  }
+
+  bool rc = (*tiling_func)(op_params, op_compile_info, run_info);
+
+  if (elapse) {
+    after_tiling = std::chrono::steady_clock::now();
+  }
+  if (!rc) {
+    GE_LOGE("Optiling failed. op_type:%s", optype);
+    return 0;
+  }
+
+  if (elapse) {
+    *elapse = std::chrono::duration_cast<std::chrono::microseconds>(after_tiling - before_tiling).count();
+    *(elapse + 1) = last_op_tiling_perf;
+    last_op_tiling_perf = -1;
+  }
+
+  GELOGI("Optiling succeed. op_type:%s", optype);
+  return DumpRunInfoBin(run_info, *run_info_buf) ? 1 : 0;
+}
+
 extern "C" int TbeOpTilingPyInterfaceEx(const char *optype, const char *compile_info, const char *inputs,
                                         const char *outputs, char *run_info_json, size_t run_info_len,
                                         uint64_t *elapse) {
@@ -386,11 +703,17 @@ extern "C" int TbeOpTilingPyInterface(const char *optype, const char *compile_in
   return TbeOpTilingPyInterfaceEx(optype, compile_info, inputs, outputs, run_info_json, run_info_len, nullptr);
 }
 
-extern "C" ge::graphStatus OpParaCalculate(const ge::Node &node, OpRunInfo &run_info) {
+// op_param is cleared and refilled, so one instance can be reused across nodes
+ge::graphStatus DoOpParaCalculate(const ge::Node &node, const OpTilingFunc *tiling_func, TeOpParas &op_param,
+                                  OpRunInfo &run_info) {
   ge::OpDescPtr op_desc = node.GetOpDesc();
-  std::string op_type = op_desc->GetType();
-  std::string op_name = op_desc->GetName();
-  TeOpParas op_param;
+  GE_CHECK_NOTNULL(op_desc);
+  const std::string &op_type = op_desc->GetTypeRef();
+  const std::string &op_name = op_desc->GetNameRef();
+  op_param.inputs.clear();
+  op_param.outputs.clear();
+  op_param.const_inputs.clear();
+  op_param.attrs.clear();
   op_param.op_type = op_type;
 
   GELOGI("Do optiling, op_type:%s, op_name:%s", op_type.c_str(), op_name.c_str());
@@ -411,26 +734,21 @@ extern "C" ge::graphStatus OpParaCalculate(const ge::Node &node, OpRunInfo &run_
 
   FeedTeOpConstTensor(node, op_desc, op_param.const_inputs);
 
-  auto &interf = OpTilingRegistryInterf::RegisteredOpInterf();
-  auto iter = interf.find(op_type);
-  if (iter == interf.end()) {
-    iter = interf.find("AutoTiling");
-  }
-  if (iter == interf.end()) {
+  if (tiling_func == nullptr) {
     GE_LOGE("Optiling func not found. op_type:%s, op_name:%s", op_type.c_str(), op_name.c_str());
     return ge::GRAPH_FAILED;
   }
 
-  OpCompileInfo op_compile_info;
-  bres = GetCompileInfo(op_desc, op_type.c_str(), op_name.c_str(), op_compile_info);
-  if (!bres) {
+  CompileInfoEntryPtr compile_info = GetCompileInfo(op_desc, op_type.c_str(), op_name.c_str());
+  if (compile_info == nullptr) {
     GE_LOGE("Failed to get compile_info, op_type:%s, op_name:%s", op_type.c_str(), op_name.c_str());
     return ge::GRAPH_FAILED;
   }
 
-  GELOGI("Optiling func found, op_type:%s, op_name:%s, func:[%s:%p]", op_type.c_str(), op_name.c_str(),
-         iter->first.c_str(), iter->second.target<OpTilingFuncPtr>());
-  bool rc = (iter->second)(op_param, op_compile_info, run_info);
+  GELOGI("Optiling func found, op_type:%s, op_name:%s, func:[%p]", op_type.c_str(), op_name.c_str(),
+         tiling_func->target<OpTilingFuncPtr>());
+  RunningCompileInfoGuard compile_info_guard(compile_info);
+  bool rc = (*tiling_func)(op_param, compile_info->info, run_info);
   if (rc) {
     GELOGI("Optiling succeed. op_type:%s, op_name:%s", op_type.c_str(), op_name.c_str());
   } else {
@@ -439,6 +757,47 @@ extern "C" ge::graphStatus OpParaCalculate(const ge::Node &node, OpRunInfo &run_
   return rc ? ge::GRAPH_SUCCESS : ge::GRAPH_FAILED;
 }
 
+extern "C" ge::graphStatus OpParaCalculate(const ge::Node &node, OpRunInfo &run_info) {
+  ge::OpDescPtr op_desc = node.GetOpDesc();
+  GE_CHECK_NOTNULL(op_desc);
+  TeOpParas op_param;
+  return DoOpParaCalculate(node, FindOpTilingFunc(op_desc->GetTypeRef()), op_param, run_info);
+}
+
+extern "C" ge::graphStatus OpParaCalculateBatch(const ge::Node *const *nodes, size_t node_num, OpRunInfo *run_infos,
+                                                uint32_t thread_num) {
+  if ((node_num > 0) && ((nodes == nullptr) || (run_infos == nullptr))) {
+    GE_LOGE("nodes or run_infos is null, node num %zu", node_num);
+    return ge::GRAPH_FAILED;
+  }
+  // resolve tiling functions of all nodes once before any tiling runs
+  std::vector<const OpTilingFunc *> tiling_funcs(node_num, nullptr);
+  for (size_t i = 0; i < node_num; ++i) {
+    if ((nodes[i] == nullptr) || (nodes[i]->GetOpDesc() == nullptr)) {
+      GE_LOGE("node or its op desc is null, index %zu", i);
+      return ge::GRAPH_FAILED;
+    }
+    tiling_funcs[i] = FindOpTilingFunc(nodes[i]->GetTypeRef());
+  }
+
+  // tiling functions are third party code, they run concurrently only if the caller asks for it
+  if (thread_num <= 1) {
+    TeOpParas op_param;
+    for (size_t i = 0; i < node_num; ++i) {
+      if (DoOpParaCalculate(*nodes[i], tiling_funcs[i], op_param, run_infos[i]) != ge::GRAPH_SUCCESS) {
+        return ge::GRAPH_FAILED;
+      }
+    }
+    return ge::GRAPH_SUCCESS;
+  }
+
+  auto tiling_task = [nodes, run_infos, &tiling_funcs](size_t index) {
+    TeOpParas op_param;
+    return DoOpParaCalculate(*nodes[index], tiling_funcs[index], op_param, run_infos[index]) == ge::GRAPH_SUCCESS;
+  };
+  return ge::ParallelFor(node_num, thread_num, tiling_task) ? ge::GRAPH_SUCCESS : ge::GRAPH_FAILED;
+}
+
 extern "C" ge::graphStatus OpAtomicCalculate(const ge::Node &node, OpRunInfo &run_info) {
   ge::OpDescPtr op_desc = node.GetOpDesc();
   std::string op_type = "DynamicAtomicAddrClean";
@@ -472,9 +831,8 @@ extern "C" ge::graphStatus OpAtomicCalculate(const ge::Node &node, OpRunInfo &ru
   op_param.const_inputs.emplace("workspace_size",
                                 TeConstTensorData(nullptr, static_cast<size_t>(clean_size), ge::Tensor()));
 
-  auto &interf = OpTilingRegistryInterf::RegisteredOpInterf();
-  auto iter = interf.find(op_type);
-  if (iter == interf.end()) {
+  const OpTilingFunc *tiling_func = OpTilingRegistryInterf::GetOpTilingFunc(op_type);
+  if (tiling_func == nullptr) {
     GE_LOGE("Atomic optiling func not found. op_type:%s, op_name:%s", op_type.c_str(), op_name.c_str());
     return ge::GRAPH_FAILED;
   }
@@ -492,14 +850,14 @@ extern "C" ge::graphStatus OpAtomicCalculate(const ge::Node &node, OpRunInfo &ru
     return ge::GRAPH_FAILED;
   }
 
-  OpCompileInfo op_compile_info;
-  bool bres = GetCompileInfo(atomic_op_desc, op_type.c_str(), op_name.c_str(), op_compile_info);
-  if (!bres) {
+  CompileInfoEntryPtr compile_info = GetCompileInfo(atomic_op_desc, op_type.c_str(), op_name.c_str());
+  if (compile_info == nullptr) {
     GE_LOGE("Failed to get compile_info, op_type:%s, op_name:%s", op_type.c_str(), op_name.c_str());
     return ge::GRAPH_FAILED;
   }
 
-  bool rc = (iter->second)(op_param, op_compile_info, run_info);
+  RunningCompileInfoGuard compile_info_guard(compile_info);
+  bool rc = (*tiling_func)(op_param, compile_info->info, run_info);
   if (rc) {
     GELOGI("Atomic optiling succeed. op_type:%s, op_name:%s", op_type.c_str(), op_name.c_str());
   } else {
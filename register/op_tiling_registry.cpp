@@ -17,9 +17,20 @@
 #include "register/op_tiling_registry.h"
 
 #include <random>
+#include <unordered_map>
 #include "framework/common/debug/ge_log.h"
+#include "graph/utils/frozen_registry.h"
 
 namespace optiling {
+namespace {
+// values point into RegisteredOpInterf(), whose entries are never erased, so they outlive a dropped table
+using OpTilingFuncMap = std::unordered_map<std::string, const OpTilingFunc *>;
+
+ge::FrozenRegistry<OpTilingFuncMap> &GetFrozenInterf() {
+  static ge::FrozenRegistry<OpTilingFuncMap> frozen_interf;
+  return frozen_interf;
+}
+}  // namespace
 
 thread_local int64_t last_op_tiling_perf = -1;
 
@@ -30,11 +41,32 @@ std::map<std::string, OpTilingFunc> &OpTilingRegistryInterf::RegisteredOpInterf(
 
 OpTilingRegistryInterf::OpTilingRegistryInterf(std::string op_type, OpTilingFunc func) {
   auto &interf = RegisteredOpInterf();
-  interf.emplace(op_type, func);
+  GetFrozenInterf().Update([&interf, &op_type, &func]() { return interf.emplace(op_type, func).second; });
   GELOGI("Register tiling function: op_type:%s, funcPointer:%p, registered count:%zu", op_type.c_str(),
          func.target<OpTilingFuncPtr>(), interf.size());
 }
 
+const OpTilingFunc *OpTilingRegistryInterf::GetOpTilingFunc(const std::string &op_type) {
+  auto frozen = GetFrozenInterf().GetOrFreeze([](const OpTilingFuncMap *, OpTilingFuncMap &table) {
+    const auto &interf = RegisteredOpInterf();
+    table.reserve(interf.size());
+    for (const auto &item : interf) {
+      (void)table.emplace(item.first, &item.second);
+    }
+    GELOGI("Freeze tiling registry, registered count:%zu", table.size());
+    return true;
+  });
+  if (frozen != nullptr) {
+    auto iter = frozen->find(op_type);
+    return (iter == frozen->end()) ? nullptr : iter->second;
+  }
+  GELOGW("Failed to freeze tiling registry, look up %s in registered map.", op_type.c_str());
+  std::lock_guard<std::mutex> lock(GetFrozenInterf().GetMutex());
+  const auto &interf = RegisteredOpInterf();
+  auto iter = interf.find(op_type);
+  return (iter == interf.end()) ? nullptr : &iter->second;
+}
+
 size_t ByteBufferGetAll(ByteBuffer &buf, char *dest, size_t dest_len) {
   size_t nread = 0;
   size_t rn = 0;
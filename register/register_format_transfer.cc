@@ -16,9 +16,28 @@
 
 #include "register/register_format_transfer.h"
 
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <mutex>
+#include "securec.h"
+#include "framework/common/debug/ge_log.h"
+#include "graph/utils/frozen_registry.h"
+#include "graph/utils/parallel_utils.h"
+
 namespace ge {
 namespace formats {
 namespace {
+const size_t kFormatNum = static_cast<size_t>(FORMAT_RESERVED);
+const size_t kMaxMemcpyLen = 0x7fffffffUL;  // SECUREC_MEM_MAX_LEN
+
+// Registered builders, with a dense [src_format][dst_format] table of their positions
+struct FormatTransferTable {
+  std::vector<FormatTransferBuilder> builders;
+  // position in builders plus 1, 0 means no transfer registered
+  std::vector<uint32_t> slots;
+};
+
 struct FormatTransferRegistry {
   Status RegisterBuilder(Format src, Format dst, FormatTransferBuilder builder) {
     src_dst_builder[src][dst] = std::move(builder);
@@ -31,16 +50,125 @@ FormatTransferRegistry &GetFormatTransferRegistry() {
   static FormatTransferRegistry registry;
   return registry;
 }
+
+FrozenRegistry<FormatTransferTable> &GetFrozenTable() {
+  static FrozenRegistry<FormatTransferTable> frozen_table;
+  return frozen_table;
+}
+
+bool IsInTable(Format src, Format dst) {
+  return (static_cast<size_t>(src) < kFormatNum) && (static_cast<size_t>(dst) < kFormatNum);
+}
+
+bool BuildFormatTransferTable(const FormatTransferTable *last, FormatTransferTable &table) {
+  (void)last;
+  table.slots.assign(kFormatNum * kFormatNum, 0);
+  for (const auto &src_iter : GetFormatTransferRegistry().src_dst_builder) {
+    for (const auto &dst_iter : src_iter.second) {
+      if (!IsInTable(src_iter.first, dst_iter.first)) {
+        continue;
+      }
+      table.builders.emplace_back(dst_iter.second);
+      table.slots[src_iter.first * kFormatNum + dst_iter.first] = static_cast<uint32_t>(table.builders.size());
+    }
+  }
+  GELOGI("Freeze format transfer registry, registered count:%zu", table.builders.size());
+  return true;
+}
+
+// 'frozen' is false if the formats are out of the table or the table can not be built,
+// then the caller falls back to the registry
+std::shared_ptr<const FormatTransferBuilder> GetFrozenBuilder(Format src, Format dst, bool &frozen) {
+  frozen = false;
+  if (!IsInTable(src, dst)) {
+    return nullptr;
+  }
+  auto table = GetFrozenTable().GetOrFreeze(BuildFormatTransferTable);
+  if (table == nullptr) {
+    GELOGW("Failed to create frozen format transfer table.");
+    return nullptr;
+  }
+  frozen = true;
+  uint32_t slot = table->slots[src * kFormatNum + dst];
+  return (slot == 0) ? nullptr : std::shared_ptr<const FormatTransferBuilder>(table, &table->builders[slot - 1]);
+}
+
+Status CopyToBuffer(const uint8_t *src, size_t length, TransBuffer &dst) {
+  if (length > dst.length) {
+    GELOGE(FAILED, "Dst buffer length %zu is less than result length %zu.", dst.length, length);
+    return FAILED;
+  }
+  // memcpy_s limits the length of each copy
+  for (size_t offset = 0; offset < length; offset += kMaxMemcpyLen) {
+    size_t copy_len = std::min(length - offset, kMaxMemcpyLen);
+    if (memcpy_s(dst.data + offset, dst.length - offset, src + offset, copy_len) != EOK) {
+      GELOGE(FAILED, "Failed to copy result to dst buffer, offset %zu, length %zu.", offset, copy_len);
+      return FAILED;
+    }
+  }
+  return SUCCESS;
+}
+
+// Adapter for transfers which only allocate their own result
+Status TransFormatByCopy(FormatTransfer &transfer, const TransArgsView &args, TransBuffer &dst) {
+  TransArgs trans_args;
+  trans_args.data = args.data;
+  trans_args.src_format = args.src_format;
+  trans_args.dst_format = args.dst_format;
+  trans_args.src_shape.assign(args.src_shape, args.src_shape + args.src_dim_num);
+  trans_args.dst_shape.assign(args.dst_shape, args.dst_shape + args.dst_dim_num);
+  trans_args.src_data_type = args.src_data_type;
+  TransResult result;
+  Status ret = transfer.TransFormat(trans_args, result);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+  if ((result.length > 0) && (result.data == nullptr)) {
+    GELOGE(FAILED, "Result data is null, length %zu.", result.length);
+    return FAILED;
+  }
+  return CopyToBuffer(result.data.get(), result.length, dst);
+}
+
+// Tiles write into dst by the dst shape, so dst must hold all of it
+bool GetTiledDstSize(const TransArgsView &args, size_t &size) {
+  int type_size = GetSizeByDataType(args.src_data_type);
+  if (type_size <= 0) {
+    return false;
+  }
+  size = static_cast<size_t>(type_size);
+  for (size_t i = 0; i < args.dst_dim_num; ++i) {
+    if (args.dst_shape[i] < 0) {
+      return false;
+    }
+    size_t dim = static_cast<size_t>(args.dst_shape[i]);
+    if ((dim != 0) && (size > std::numeric_limits<size_t>::max() / dim)) {
+      return false;
+    }
+    size *= dim;
+  }
+  return true;
+}
 }  // namespace
 
 FormatTransferRegister::FormatTransferRegister(FormatTransferBuilder builder, Format src, Format dst) {
-  (void)GetFormatTransferRegistry().RegisterBuilder(src, dst, std::move(builder));
-  // RegisterBuilder() always return success, no need to check value
+  // Registration after freeze, e.g. by a plugin loaded later, drops the table and it is rebuilt on next lookup
+  GetFrozenTable().Update([&builder, src, dst]() {
+    (void)GetFormatTransferRegistry().RegisterBuilder(src, dst, std::move(builder));
+    // RegisterBuilder() always return success, no need to check value
+    return true;
+  });
 }
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY std::shared_ptr<FormatTransfer> BuildFormatTransfer(
     const TransArgs &args) {
-  auto registry = GetFormatTransferRegistry();
+  bool frozen = false;
+  auto builder = GetFrozenBuilder(args.src_format, args.dst_format, frozen);
+  if (frozen) {
+    return (builder == nullptr) ? nullptr : (*builder)();
+  }
+  std::lock_guard<std::mutex> lock(GetFrozenTable().GetMutex());
+  const auto &registry = GetFormatTransferRegistry();
   auto dst_builder = registry.src_dst_builder.find(args.src_format);
   if (dst_builder == registry.src_dst_builder.end()) {
     return nullptr;
@@ -53,12 +181,61 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY std::shared_ptr<FormatTransfer> B
 }
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool FormatTransferExists(const TransArgs &args) {
-  auto registry = GetFormatTransferRegistry();
+  bool frozen = false;
+  auto builder = GetFrozenBuilder(args.src_format, args.dst_format, frozen);
+  if (frozen) {
+    return builder != nullptr;
+  }
+  std::lock_guard<std::mutex> lock(GetFrozenTable().GetMutex());
+  const auto &registry = GetFormatTransferRegistry();
   auto dst_builder = registry.src_dst_builder.find(args.src_format);
   if (dst_builder == registry.src_dst_builder.end()) {
     return false;
   }
   return dst_builder->second.count(args.dst_format) > 0;
 }
+
+GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY Status TransFormatToBuffer(const TransArgsView &args,
+                                                                          TransBuffer &dst, uint32_t thread_num) {
+  if (((args.src_shape == nullptr) && (args.src_dim_num > 0)) ||
+      ((args.dst_shape == nullptr) && (args.dst_dim_num > 0)) || ((dst.data == nullptr) && (dst.length > 0))) {
+    GELOGE(FAILED, "Invalid args of format transfer from %d to %d.", args.src_format, args.dst_format);
+    return FAILED;
+  }
+  TransArgs lookup_args;
+  lookup_args.src_format = args.src_format;
+  lookup_args.dst_format = args.dst_format;
+  std::shared_ptr<FormatTransfer> transfer = BuildFormatTransfer(lookup_args);
+  if (transfer == nullptr) {
+    GELOGE(FAILED, "Format transfer from %d to %d is not supported.", args.src_format, args.dst_format);
+    return FAILED;
+  }
+
+  auto tiled_transfer = dynamic_cast<TiledFormatTransfer *>(transfer.get());
+  size_t tile_num = (tiled_transfer == nullptr) ? 0 : tiled_transfer->GetTileNum(args);
+  if (tile_num == 0) {
+    return TransFormatByCopy(*transfer, args, dst);
+  }
+  size_t dst_size = 0;
+  if (!GetTiledDstSize(args, dst_size)) {
+    GELOGE(FAILED, "Invalid dst shape or data type %d of format transfer from %d to %d.", args.src_data_type,
+           args.src_format, args.dst_format);
+    return FAILED;
+  }
+  if (dst_size > dst.length) {
+    GELOGE(FAILED, "Dst buffer length %zu is less than result length %zu.", dst.length, dst_size);
+    return FAILED;
+  }
+
+  // tiles are of similar size, workers take them one by one so a slow thread does not hold the others
+  auto trans_task = [tiled_transfer, &args, &dst](size_t tile) {
+    if (tiled_transfer->TransFormatTile(args, tile, dst) != SUCCESS) {
+      GELOGE(FAILED, "Failed to trans tile %zu from format %d to %d.", tile, args.src_format, args.dst_format);
+      return false;
+    }
+    return true;
+  };
+  return ParallelFor(tile_num, thread_num, trans_task) ? SUCCESS : FAILED;
+}
 }  // namespace formats
 }  // namespace ge
@@ -23,6 +23,7 @@
 #include "graph/utils/op_desc_utils.h"
 #include "graph/utils/type_utils.h"
 #include "graph/utils/attr_utils.h"
+#include "graph/utils/parallel_utils.h"
 #include "register/register_error_codes.h"
 #include "register/tensor_assign.h"
 
@@ -33,6 +34,36 @@ namespace domi {
 namespace {
 const uint32_t kExtraBytesForString = sizeof(int64_t) + 1;
 const char *const kOriginElementNumAttrName = "origin_element_num";
+
+// Narrow int32 values to a smaller integer type. Kept as a plain contiguous loop
+// over raw pointers so that the compiler can vectorize it.
+template <typename DstT>
+void NarrowInt32Val(const int32 *src, int32_t num, DstT *dst) {
+  for (int32_t i = 0; i < num; ++i) {
+    dst[i] = static_cast<DstT>(src[i]);
+  }
+}
+
+template <typename DstT>
+Status GetNarrowVal(int32_t val_size, const google::protobuf::RepeatedField<int32> &val_vector, int count,
+                    GeTensorPtr &weight) {
+  GE_CHECK_NOTNULL(weight);
+  bool zerosLike = (count != val_size && val_size == 1);
+  std::unique_ptr<DstT[]> addr(new (std::nothrow) DstT[count]());
+  GE_CHECK_NOTNULL(addr);
+  const int32 *src = val_vector.data();
+  int minCount = (count > val_size) ? val_size : count;
+  if (!zerosLike) {
+    NarrowInt32Val(src, minCount, addr.get());
+    if (minCount > 0) {
+      std::fill(addr.get() + minCount, addr.get() + count, static_cast<DstT>(src[minCount - 1]));
+    }
+  } else {
+    std::fill(addr.get(), addr.get() + count, static_cast<DstT>(src[0]));
+  }
+  weight->SetData(reinterpret_cast<uint8_t *>(addr.get()), count * sizeof(DstT));
+  return SUCCESS;
+}
 }  // namespace
 
 static const std::map<uint32_t, ge::DataType> data_type_map = {
@@ -153,50 +184,12 @@ bool TensorAssign::CheckUnsignedEightByte(tensorflow::DataType data_type) {
 
 Status TensorAssign::GetDoubleByteVal(int32_t val_size, const google::protobuf::RepeatedField<int32> &val_vector,
                                       int count, GeTensorPtr &weight) {
-  GE_CHECK_NOTNULL(weight);
-  bool zerosLike = (count != val_size && val_size == 1);
-  uint16_t *addr = new (std::nothrow) uint16_t[count]();
-  GE_CHECK_NOTNULL(addr);
-  int minCount = (count > val_size) ? val_size : count;
-  if (!zerosLike) {
-    for (int32_t i = 0; i < minCount; i++) {
-      *(addr + i) = static_cast<uint16_t>(val_vector.Get(i));
-    }
-    for (int32_t i = minCount; i < count; i++) {
-      *(addr + i) = static_cast<uint16_t>(val_vector.Get(minCount - 1));
-    }
-  } else {
-    for (int32_t i = 0; i < count; i++) {
-      *(addr + i) = static_cast<uint16_t>(val_vector.Get(0));
-    }
-  }
-  weight->SetData(reinterpret_cast<uint8_t *>(addr), count * sizeof(uint16_t));
-  GE_DELETE_NEW_ARRAY(addr);
-  return SUCCESS;
+  return GetNarrowVal<uint16_t>(val_size, val_vector, count, weight);
 }
 
 Status TensorAssign::GetByteVal(int32_t val_size, const google::protobuf::RepeatedField<int32> &val_vector, int count,
                                 GeTensorPtr &weight) {
-  GE_CHECK_NOTNULL(weight);
-  bool zerosLike = (count != val_size && val_size == 1);
-  uint8_t *addr = new (std::nothrow) uint8_t[count]();
-  GE_CHECK_NOTNULL(addr);
-  int minCount = (count > val_size) ? val_size : count;
-  if (!zerosLike) {
-    for (int32_t i = 0; i < minCount; i++) {
-      *(addr + i) = static_cast<uint8_t>(val_vector.Get(i));
-    }
-    for (int32_t i = minCount; i < count; i++) {
-      *(addr + i) = static_cast<uint8_t>(val_vector.Get(minCount - 1));
-    }
-  } else {
-    for (int32_t i = 0; i < count; i++) {
-      *(addr + i) = static_cast<uint8_t>(val_vector.Get(0));
-    }
-  }
-  weight->SetData(addr, count * sizeof(uint8_t));
-  GE_DELETE_NEW_ARRAY(addr);
-  return SUCCESS;
+  return GetNarrowVal<uint8_t>(val_size, val_vector, count, weight);
 }
 
 Status TensorAssign::GetStringVal(int32_t val_size, const google::protobuf::RepeatedPtrField<std::string> &val_vector,
@@ -307,63 +300,91 @@ void TensorAssign::SetWeightData(tensorflow::DataType data_type, int count, cons
   }
 }
 
+bool TensorAssign::GetValSize(const TensorProto &tensor, int32_t &val_size) {
+  switch (tensor.dtype()) {
+    case tensorflow::DT_FLOAT:
+    case tensorflow::DT_FLOAT_REF:
+      val_size = tensor.float_val().size();
+      break;
+    case tensorflow::DT_INT32:
+    case tensorflow::DT_INT8:
+    case tensorflow::DT_UINT8:
+    case tensorflow::DT_INT16:
+    case tensorflow::DT_UINT16:
+    case tensorflow::DT_QINT8:
+    case tensorflow::DT_QINT16:
+    case tensorflow::DT_QINT32:
+    case tensorflow::DT_QUINT8:
+    case tensorflow::DT_QUINT16:
+    case tensorflow::DT_INT32_REF:
+    case tensorflow::DT_INT8_REF:
+    case tensorflow::DT_UINT8_REF:
+    case tensorflow::DT_INT16_REF:
+    case tensorflow::DT_UINT16_REF:
+    case tensorflow::DT_QINT8_REF:
+    case tensorflow::DT_QINT16_REF:
+    case tensorflow::DT_QINT32_REF:
+    case tensorflow::DT_QUINT8_REF:
+    case tensorflow::DT_QUINT16_REF:
+      val_size = tensor.int_val().size();
+      break;
+    case tensorflow::DT_INT64:
+    case tensorflow::DT_INT64_REF:
+      val_size = tensor.int64_val().size();
+      break;
+    case tensorflow::DT_BOOL:
+    case tensorflow::DT_BOOL_REF:
+      val_size = tensor.bool_val().size();
+      break;
+    case tensorflow::DT_HALF:
+    case tensorflow::DT_BFLOAT16:
+    case tensorflow::DT_HALF_REF:
+    case tensorflow::DT_BFLOAT16_REF:
+      val_size = tensor.half_val().size();
+      break;
+    case tensorflow::DT_DOUBLE:
+    case tensorflow::DT_DOUBLE_REF:
+      val_size = tensor.double_val().size();
+      break;
+    case tensorflow::DT_STRING:
+    case tensorflow::DT_STRING_REF:
+      val_size = tensor.string_val().size();
+      break;
+    case tensorflow::DT_COMPLEX64:
+    case tensorflow::DT_COMPLEX64_REF:
+      val_size = tensor.scomplex_val().size();
+      break;
+    case tensorflow::DT_COMPLEX128:
+    case tensorflow::DT_COMPLEX128_REF:
+      val_size = tensor.dcomplex_val().size();
+      break;
+    case tensorflow::DT_UINT32:
+    case tensorflow::DT_UINT32_REF:
+      val_size = tensor.uint32_val().size();
+      break;
+    case tensorflow::DT_UINT64:
+    case tensorflow::DT_UINT64_REF:
+      val_size = tensor.uint64_val().size();
+      break;
+    case tensorflow::DT_RESOURCE:
+    case tensorflow::DT_RESOURCE_REF:
+      val_size = tensor.resource_handle_val().size();
+      break;
+    case tensorflow::DT_VARIANT:
+    case tensorflow::DT_VARIANT_REF:
+      val_size = tensor.variant_val().size();
+      break;
+    default:
+      return false;
+  }
+  return true;
+}
+
 Status TensorAssign::SetGeTensor(const TensorProto &tensor, GeTensorPtr &weight) {
   GE_CHECK_NOTNULL(weight);
-  std::map<tensorflow::DataType, int32_t> datatype_val_size_map = {
-      {tensorflow::DT_FLOAT, tensor.float_val().size()},
-      {tensorflow::DT_INT32, tensor.int_val().size()},
-      {tensorflow::DT_INT64, tensor.int64_val().size()},
-      {tensorflow::DT_BOOL, tensor.bool_val().size()},
-      {tensorflow::DT_HALF, tensor.half_val().size()},
-      {tensorflow::DT_INT8, tensor.int_val().size()},
-      {tensorflow::DT_UINT8, tensor.int_val().size()},
-      {tensorflow::DT_INT16, tensor.int_val().size()},
-      {tensorflow::DT_UINT16, tensor.int_val().size()},
-      {tensorflow::DT_DOUBLE, tensor.double_val().size()},
-      {tensorflow::DT_STRING, tensor.string_val().size()},
-      {tensorflow::DT_QINT8, tensor.int_val().size()},
-      {tensorflow::DT_QINT16, tensor.int_val().size()},
-      {tensorflow::DT_QINT32, tensor.int_val().size()},
-      {tensorflow::DT_QUINT8, tensor.int_val().size()},
-      {tensorflow::DT_QUINT16, tensor.int_val().size()},
-      {tensorflow::DT_COMPLEX64, tensor.scomplex_val().size()},
-      {tensorflow::DT_COMPLEX128, tensor.dcomplex_val().size()},
-      {tensorflow::DT_BFLOAT16, tensor.half_val().size()},
-      {tensorflow::DT_UINT32, tensor.uint32_val().size()},
-      {tensorflow::DT_UINT64, tensor.uint64_val().size()},
-      {tensorflow::DT_RESOURCE, tensor.resource_handle_val().size()},
-      {tensorflow::DT_VARIANT, tensor.variant_val().size()},
-      {tensorflow::DT_FLOAT_REF, tensor.float_val().size()},
-      {tensorflow::DT_INT32_REF, tensor.int_val().size()},
-      {tensorflow::DT_INT64_REF, tensor.int64_val().size()},
-      {tensorflow::DT_BOOL_REF, tensor.bool_val().size()},
-      {tensorflow::DT_HALF_REF, tensor.half_val().size()},
-      {tensorflow::DT_INT8_REF, tensor.int_val().size()},
-      {tensorflow::DT_UINT8_REF, tensor.int_val().size()},
-      {tensorflow::DT_INT16_REF, tensor.int_val().size()},
-      {tensorflow::DT_UINT16_REF, tensor.int_val().size()},
-      {tensorflow::DT_DOUBLE_REF, tensor.double_val().size()},
-      {tensorflow::DT_STRING_REF, tensor.string_val().size()},
-      {tensorflow::DT_QINT8_REF, tensor.int_val().size()},
-      {tensorflow::DT_QINT16_REF, tensor.int_val().size()},
-      {tensorflow::DT_QINT32_REF, tensor.int_val().size()},
-      {tensorflow::DT_QUINT8_REF, tensor.int_val().size()},
-      {tensorflow::DT_QUINT16_REF, tensor.int_val().size()},
-      {tensorflow::DT_COMPLEX64_REF, tensor.scomplex_val().size()},
-      {tensorflow::DT_COMPLEX128_REF, tensor.dcomplex_val().size()},
-      {tensorflow::DT_BFLOAT16_REF, tensor.half_val().size()},
-      {tensorflow::DT_UINT32_REF, tensor.uint32_val().size()},
-      {tensorflow::DT_UINT64_REF, tensor.uint64_val().size()},
-      {tensorflow::DT_RESOURCE_REF, tensor.resource_handle_val().size()},
-      {tensorflow::DT_VARIANT_REF, tensor.variant_val().size()},
-  };
   tensorflow::DataType data_type = tensor.dtype();
   int32_t datatype_val_size = 0;
-
-  auto iter = datatype_val_size_map.find(data_type);
-  if (iter != datatype_val_size_map.end()) {
-    datatype_val_size = iter->second;
-  } else {
+  if (!GetValSize(tensor, datatype_val_size)) {
     GE_CHECK_GE(data_type, 0);
     GE_LOGE("datatype:%s not support.", DataType_Name(data_type).c_str());
     return FAILED;
@@ -384,15 +405,12 @@ Status TensorAssign::SetGeTensor(const TensorProto &tensor, GeTensorPtr &weight)
                                        "Dim size exceeds INT64_MAX");
         count *= dim;
       });
-  GeShape shape(shape_vec);
-  GeTensorDesc tmp_desc = weight->GetTensorDesc();
-  tmp_desc.SetShape(shape);
+  GeTensorDesc &weight_desc = weight->MutableTensorDesc();
+  weight_desc.SetShape(GeShape(shape_vec));
 
   // Fixed input ND
-  tmp_desc.SetFormat(ge::Format::FORMAT_ND);
-  tmp_desc.SetOriginFormat(ge::Format::FORMAT_ND);
-
-  weight->SetTensorDesc(tmp_desc);
+  weight_desc.SetFormat(ge::Format::FORMAT_ND);
+  weight_desc.SetOriginFormat(ge::Format::FORMAT_ND);
 
   if (datatype_val_size > 0) {
     SetGeTensorWeightData(tensor, datatype_val_size, count, weight);
@@ -414,6 +432,27 @@ Status TensorAssign::SetGeTensor(const TensorProto &tensor, GeTensorPtr &weight)
   return SUCCESS;
 }
 
+Status TensorAssign::SetGeTensors(const std::vector<const TensorProto *> &tensors, std::vector<GeTensorPtr> &weights,
+                                  uint32_t thread_num) {
+  if (tensors.size() != weights.size()) {
+    GE_LOGE("tensors size %zu is not equal to weights size %zu.", tensors.size(), weights.size());
+    return FAILED;
+  }
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    GE_CHECK_NOTNULL(tensors[i]);
+    GE_CHECK_NOTNULL(weights[i]);
+  }
+  // consts differ a lot in size, so workers take tensors one by one instead of fixed ranges
+  auto decode_task = [&tensors, &weights](size_t index) {
+    if (SetGeTensor(*tensors[index], weights[index]) != SUCCESS) {
+      GE_LOGE("Set ge tensor failed, index %zu.", index);
+      return false;
+    }
+    return true;
+  };
+  return ge::ParallelFor(tensors.size(), thread_num, decode_task) ? SUCCESS : FAILED;
+}
+
 Status TensorAssign::SetGeTensorDataType(int64_t data_type, GeTensorPtr &weight) {
   GE_CHECK_NOTNULL(weight);
   GeTensorDesc tmp_desc = weight->GetTensorDesc();